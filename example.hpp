@@ -23,8 +23,11 @@ namespace example {
  * - Multiple temperature readings are combined
  * - Alerts are generated when thresholds are exceeded
  * - All without dynamic memory allocation
+ * 
+ * @tparam Layout Layout policy of the graph (e.g. a profiled or generated layout)
  */
-class TemperatureSensorSystem {
+template<typename Layout = frp::by_alignment>
+class BasicTemperatureSensorSystem {
 private:
     // Input cells (raw sensor values)
     frp::Cell<float> sensor1_raw_;
@@ -42,13 +45,14 @@ private:
     static constexpr float HIGH_TEMP_THRESHOLD = 50.0f;
     
     // The reactive graph
-    using Graph = frp::ReactiveGraph<
+    using Graph = frp::BasicReactiveGraph<Layout,
         frp::Cell<float>, // sensor1_raw_
         frp::Cell<float>, // sensor2_raw_
         frp::Cell<float>, // sensor1_celsius_
         frp::Cell<float>, // sensor2_celsius_
         frp::Cell<float>, // average_temperature_
-        frp::Cell<bool>   // high_temp_alert_
+        frp::Cell<bool>,  // high_temp_alert_
+        frp::ConstCell<HIGH_TEMP_THRESHOLD> // alert threshold, fixed per build
     >;
     
     Graph graph_;
@@ -59,18 +63,24 @@ private:
         return (raw_value * 0.1f) - 20.0f;
     }
     
+    // The graph must fit the sensor node's budget
+    static_assert(frp::fits_memory_budget<8 * 1024, Graph>,
+                  "Temperature sensor system exceeds its memory budget");
+    
     // Function to check if temperature exceeds threshold
-    static constexpr bool is_high_temperature(float temp) {
-        return temp > HIGH_TEMP_THRESHOLD;
+    static constexpr bool is_high_temperature(float temp, float threshold) {
+        return temp > threshold;
     }
     
 public:
     /**
      * @brief Constructor
      * 
-     * Initializes the FRP graph with initial values
+     * Initializes the FRP graph with initial values. The constructor is a
+     * constant expression, so the system can be declared `constinit` and its
+     * propagated start state is computed by the compiler.
      */
-    constexpr TemperatureSensorSystem()
+    constexpr BasicTemperatureSensorSystem()
         : sensor1_raw_(0.0f)
         , sensor2_raw_(0.0f)
         , sensor1_celsius_(0.0f)
@@ -83,7 +93,8 @@ public:
             sensor1_celsius_,
             sensor2_celsius_,
             average_temperature_,
-            high_temp_alert_
+            high_temp_alert_,
+            frp::ConstCell<HIGH_TEMP_THRESHOLD>{}
           )
     {
         // Initial update to establish the graph relationships
@@ -94,7 +105,7 @@ public:
      * @brief Update sensor 1 with a new raw value
      */
     constexpr void update_sensor1(float raw_value) {
-        graph_.get_cell<0>().set_value(raw_value);
+        graph_.template get_cell<0>().set_value(raw_value);
         update_graph();
     }
     
@@ -102,7 +113,7 @@ public:
      * @brief Update sensor 2 with a new raw value
      */
     constexpr void update_sensor2(float raw_value) {
-        graph_.get_cell<1>().set_value(raw_value);
+        graph_.template get_cell<1>().set_value(raw_value);
         update_graph();
     }
     
@@ -110,28 +121,28 @@ public:
      * @brief Get the current temperature from sensor 1
      */
     constexpr float get_sensor1_temperature() const {
-        return graph_.get_cell<2>().value();
+        return graph_.template get_cell<2>().value();
     }
     
     /**
      * @brief Get the current temperature from sensor 2
      */
     constexpr float get_sensor2_temperature() const {
-        return graph_.get_cell<3>().value();
+        return graph_.template get_cell<3>().value();
     }
     
     /**
      * @brief Get the current average temperature
      */
     constexpr float get_average_temperature() const {
-        return graph_.get_cell<4>().value();
+        return graph_.template get_cell<4>().value();
     }
     
     /**
      * @brief Check if high temperature alert is active
      */
     constexpr bool is_alert_active() const {
-        return graph_.get_cell<5>().value();
+        return graph_.template get_cell<5>().value();
     }
     
 private:
@@ -142,32 +153,38 @@ private:
      */
     constexpr void update_graph() {
         // Update sensor1_celsius from sensor1_raw
-        graph_.update_cell<2>([](const auto& cells) {
+        graph_.template update_cell<2>([](const auto& cells) {
             const auto& raw = std::get<0>(cells).value();
             return raw_to_celsius(raw);
         });
         
         // Update sensor2_celsius from sensor2_raw
-        graph_.update_cell<3>([](const auto& cells) {
+        graph_.template update_cell<3>([](const auto& cells) {
             const auto& raw = std::get<1>(cells).value();
             return raw_to_celsius(raw);
         });
         
         // Update average_temperature from both celsius readings
-        graph_.update_cell<4>([](const auto& cells) {
+        graph_.template update_cell<4>([](const auto& cells) {
             const auto& temp1 = std::get<2>(cells).value();
             const auto& temp2 = std::get<3>(cells).value();
             return (temp1 + temp2) / 2.0f;
         });
         
         // Update high_temp_alert from average_temperature
-        graph_.update_cell<5>([](const auto& cells) {
+        graph_.template update_cell<5>([](const auto& cells) {
             const auto& avg_temp = std::get<4>(cells).value();
-            return is_high_temperature(avg_temp);
+            const auto& threshold = std::get<6>(cells).value();
+            return is_high_temperature(avg_temp, threshold);
         });
     }
 };
 
+/**
+ * @brief Temperature sensor system with the default graph layout
+ */
+using TemperatureSensorSystem = BasicTemperatureSensorSystem<>;
+
 /**
  * @brief Example of a signal processing system using FRP
  * 
@@ -179,9 +196,12 @@ private:
  */
 class SignalProcessingSystem {
 private:
+    // Alert text, formatted in place
+    using AlertText = frp::fixed_string<48>;
+    
     // Signal handlers (using static storage)
     frp::Sink<int> value_processor_;
-    frp::Sink<std::string> alert_handler_;
+    frp::Sink<AlertText> alert_handler_;
     
     // Counter for demonstration
     int processed_count_;
@@ -198,9 +218,9 @@ public:
             processed_count_++;
             std::cout << "Processed value: " << value << " (count: " << processed_count_ << ")" << std::endl;
         })
-        , alert_handler_([](const std::string& message) {
+        , alert_handler_([](const AlertText& message) {
             // Handle alert (in a real system, this might trigger an alarm)
-            std::cout << "ALERT: " << message << std::endl;
+            std::cout << "ALERT: " << message.view() << std::endl;
         })
         , processed_count_(0)
     {}
@@ -221,15 +241,17 @@ public:
         value_processor_.process(filtered_signal);
         
         // Transform the signal to create an alert if value is very high
-        auto alert_signal = input_signal.map([](int v) -> std::string {
+        auto alert_signal = input_signal.map([](int v) {
+            AlertText message;
             if (v > 100) {
-                return "Value exceeded critical threshold: " + std::to_string(v);
+                message += "Value exceeded critical threshold: ";
+                message.append(v);
             }
-            return "";
+            return message;
         });
         
-        // Filter empty alerts
-        auto filtered_alert = frp::filter(alert_signal, [](const std::string& s) { return !s.empty(); });
+        // Filter empty alerts (through a view, so the text is not copied again)
+        auto filtered_alert = frp::filter(alert_signal.view(), [](const AlertText& s) { return !s.empty(); });
         
         // Process the alert
         alert_handler_.process(filtered_alert);
@@ -251,8 +273,11 @@ public:
  * - Behaviors are combined using FRP principles
  * - Safety limits are enforced
  * - All without dynamic memory allocation
+ * 
+ * @tparam Layout Layout policy of the graph (e.g. a profiled or generated layout)
  */
-class MotorControlSystem {
+template<typename Layout = frp::by_alignment>
+class BasicMotorControlSystem {
 private:
     // Input cells
     frp::Cell<float> throttle_position_;
@@ -267,13 +292,16 @@ private:
     static constexpr float OVERHEAT_THRESHOLD = 80.0f;
     
     // The reactive graph
-    using Graph = frp::ReactiveGraph<
+    using Graph = frp::BasicReactiveGraph<Layout,
         frp::Cell<float>, // throttle_position_
         frp::Cell<float>, // temperature_
         frp::Cell<bool>,  // emergency_stop_
         frp::Cell<float>  // motor_power_
     >;
     
+    // Fails the build, naming the largest node, if the graph outgrows its budget
+    static_assert(Graph::template check_memory_budget<64>());
+    
     Graph graph_;
     
     // Calculate motor power based on inputs
@@ -298,9 +326,9 @@ public:
     /**
      * @brief Constructor
      * 
-     * Initializes the FRP graph with initial values
+     * Initializes the FRP graph with initial values; usable with `constinit`
      */
-    constexpr MotorControlSystem()
+    constexpr BasicMotorControlSystem()
         : throttle_position_(0.0f)
         , temperature_(25.0f)
         , emergency_stop_(false)
@@ -321,7 +349,7 @@ public:
      */
     constexpr void set_throttle(float position) {
         float clamped = std::max(0.0f, std::min(position, 1.0f));
-        graph_.get_cell<0>().set_value(clamped);
+        graph_.template get_cell<0>().set_value(clamped);
         update_graph();
     }
     
@@ -329,7 +357,7 @@ public:
      * @brief Update the temperature reading
      */
     constexpr void update_temperature(float temp) {
-        graph_.get_cell<1>().set_value(temp);
+        graph_.template get_cell<1>().set_value(temp);
         update_graph();
     }
     
@@ -337,7 +365,7 @@ public:
      * @brief Set the emergency stop state
      */
     constexpr void set_emergency_stop(bool active) {
-        graph_.get_cell<2>().set_value(active);
+        graph_.template get_cell<2>().set_value(active);
         update_graph();
     }
     
@@ -345,7 +373,7 @@ public:
      * @brief Get the current motor power level
      */
     constexpr float get_motor_power() const {
-        return graph_.get_cell<3>().value();
+        return graph_.template get_cell<3>().value();
     }
     
 private:
@@ -356,7 +384,7 @@ private:
      */
     constexpr void update_graph() {
         // Update motor_power based on all inputs
-        graph_.update_cell<3>([](const auto& cells) {
+        graph_.template update_cell<3>([](const auto& cells) {
             const auto& throttle = std::get<0>(cells).value();
             const auto& temp = std::get<1>(cells).value();
             const auto& e_stop = std::get<2>(cells).value();
@@ -365,6 +393,11 @@ private:
     }
 };
 
+/**
+ * @brief Motor control system with the default graph layout
+ */
+using MotorControlSystem = BasicMotorControlSystem<>;
+
 } // namespace example
 
 #endif // EXAMPLE_HPP
@@ -13,9 +13,17 @@
 #define FRP_HPP
 
 #include <array>
+#include <bit>
+#include <charconv>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <concepts>
 #include <functional>
+#include <initializer_list>
+#include <new>
+#include <span>
+#include <string_view>
 #include <tuple>
 #include <type_traits>
 #include <utility>
@@ -32,6 +40,16 @@ namespace detail {
      * This class provides a way to store callable objects without dynamic allocation.
      * The callable is stored in a fixed-size buffer and invoked through type erasure.
      * 
+     * Stateless callables and trivially copyable callables are stored by value
+     * (in constant expressions their bytes are copied in and out with
+     * std::bit_cast), so wrappers holding them can be built, copied and called
+     * in constant expressions. Captures of pointers or references still work at
+     * run time but cannot be evaluated by the compiler. Other callables are
+     * placement-constructed into the buffer.
+     * 
+     * The callable is invoked as const, so mutable lambdas are rejected: their
+     * state would not survive a call in constant expressions.
+     * 
      * @tparam Signature Function signature
      * @tparam BufferSize Size of the internal buffer for storing the callable
      */
@@ -44,19 +62,62 @@ namespace detail {
     template<typename R, typename... Args, std::size_t BufferSize>
     class static_function<R(Args...), BufferSize> {
     private:
+        using buffer_type = std::array<std::byte, BufferSize>;
+        
+        // Callables that can live in the buffer as plain bytes
+        template<typename F>
+        static constexpr bool stateless = std::is_empty_v<F> && std::is_default_constructible_v<F>;
+        
+        template<typename F>
+        static constexpr bool by_value = stateless<F> ||
+            (std::is_trivially_copyable_v<F> && std::is_trivially_destructible_v<F>);
+        
         // Aligned storage for the callable object
-        alignas(std::max_align_t) std::array<std::byte, BufferSize> buffer_;
+        alignas(std::max_align_t) buffer_type buffer_{};
         
         // Function pointer for invoking the stored callable
-        R (*invoker_)(const void*, Args...);
+        R (*invoker_)(const buffer_type&, Args...);
+        
+        // Function pointer for copying the stored callable (null: copy the bytes)
+        void (*copier_)(buffer_type&, const buffer_type&);
         
-        // Function pointer for copying the stored callable
-        void (*copier_)(void*, const void*);
+        // Function pointer for destroying the stored callable (null: nothing to do)
+        void (*destroyer_)(buffer_type&);
+        
+        template<typename F>
+        static constexpr void store(buffer_type& buffer, const F& f) {
+            const auto bytes = std::bit_cast<std::array<std::byte, sizeof(F)>>(f);
+            for (std::size_t i = 0; i < sizeof(F); ++i) {
+                buffer[i] = bytes[i];
+            }
+        }
+        
+        template<typename F>
+        static constexpr F load(const buffer_type& buffer) {
+            std::array<std::byte, sizeof(F)> bytes{};
+            for (std::size_t i = 0; i < sizeof(F); ++i) {
+                bytes[i] = buffer[i];
+            }
+            return std::bit_cast<F>(bytes);
+        }
         
-        // Function pointer for destroying the stored callable
-        void (*destroyer_)(void*);
+        constexpr void copy_from(const static_function& other) {
+            if (other.copier_) {
+                other.copier_(buffer_, other.buffer_);
+            } else {
+                buffer_ = other.buffer_;
+            }
+            invoker_ = other.invoker_;
+            copier_ = other.copier_;
+            destroyer_ = other.destroyer_;
+        }
 
     public:
+        /**
+         * @brief Bytes available for the stored callable
+         */
+        static constexpr std::size_t buffer_size = BufferSize;
+        
         /**
          * @brief Default constructor
          */
@@ -71,39 +132,51 @@ namespace detail {
          */
         template<typename F>
         constexpr static_function(F f)
-            requires (sizeof(F) <= BufferSize && std::is_invocable_r_v<R, F, Args...>) {
-            
-            // Store the callable in the buffer
-            new (buffer_.data()) F(std::move(f));
-            
-            // Set up function pointers
-            invoker_ = [](const void* ptr, Args... args) -> R {
-                return (*static_cast<const F*>(ptr))(std::forward<Args>(args)...);
-            };
+            requires (sizeof(F) <= BufferSize && std::is_invocable_r_v<R, const F&, Args...>)
+            : copier_(nullptr), destroyer_(nullptr) {
             
-            copier_ = [](void* dst, const void* src) {
-                new (dst) F(*static_cast<const F*>(src));
-            };
-            
-            destroyer_ = [](void* ptr) {
-                static_cast<F*>(ptr)->~F();
-            };
+            if constexpr (stateless<F>) {
+                // Nothing to store: the type is the whole callable
+                invoker_ = [](const buffer_type&, Args... args) -> R {
+                    return F{}(std::forward<Args>(args)...);
+                };
+            } else if constexpr (by_value<F>) {
+                if (std::is_constant_evaluated()) {
+                    store(buffer_, f);
+                } else {
+                    new (buffer_.data()) F(f);
+                }
+                invoker_ = [](const buffer_type& buffer, Args... args) -> R {
+                    if (std::is_constant_evaluated()) {
+                        // The buffer cannot be reinterpreted here; call a copy
+                        return load<F>(buffer)(std::forward<Args>(args)...);
+                    }
+                    return (*std::launder(reinterpret_cast<const F*>(buffer.data())))(std::forward<Args>(args)...);
+                };
+            } else {
+                // Store the callable in the buffer
+                new (buffer_.data()) F(std::move(f));
+                
+                // Set up function pointers
+                invoker_ = [](const buffer_type& buffer, Args... args) -> R {
+                    return (*std::launder(reinterpret_cast<const F*>(buffer.data())))(std::forward<Args>(args)...);
+                };
+                
+                copier_ = [](buffer_type& dst, const buffer_type& src) {
+                    new (dst.data()) F(*std::launder(reinterpret_cast<const F*>(src.data())));
+                };
+                
+                destroyer_ = [](buffer_type& buffer) {
+                    std::launder(reinterpret_cast<F*>(buffer.data()))->~F();
+                };
+            }
         }
         
         /**
          * @brief Copy constructor
          */
         constexpr static_function(const static_function& other) {
-            if (other.invoker_) {
-                other.copier_(buffer_.data(), other.buffer_.data());
-                invoker_ = other.invoker_;
-                copier_ = other.copier_;
-                destroyer_ = other.destroyer_;
-            } else {
-                invoker_ = nullptr;
-                copier_ = nullptr;
-                destroyer_ = nullptr;
-            }
+            copy_from(other);
         }
         
         /**
@@ -111,7 +184,7 @@ namespace detail {
          */
         constexpr ~static_function() {
             if (destroyer_) {
-                destroyer_(buffer_.data());
+                destroyer_(buffer_);
             }
         }
         
@@ -121,19 +194,9 @@ namespace detail {
         constexpr static_function& operator=(const static_function& other) {
             if (this != &other) {
                 if (destroyer_) {
-                    destroyer_(buffer_.data());
-                }
-                
-                if (other.invoker_) {
-                    other.copier_(buffer_.data(), other.buffer_.data());
-                    invoker_ = other.invoker_;
-                    copier_ = other.copier_;
-                    destroyer_ = other.destroyer_;
-                } else {
-                    invoker_ = nullptr;
-                    copier_ = nullptr;
-                    destroyer_ = nullptr;
+                    destroyer_(buffer_);
                 }
+                copy_from(other);
             }
             return *this;
         }
@@ -143,7 +206,7 @@ namespace detail {
          */
         constexpr R operator()(Args... args) const {
             if (invoker_) {
-                return invoker_(buffer_.data(), std::forward<Args>(args)...);
+                return invoker_(buffer_, std::forward<Args>(args)...);
             }
             // Handle empty function case
             if constexpr (std::is_same_v<R, void>) {
@@ -181,13 +244,71 @@ namespace detail {
     template<std::size_t N>
     using make_index_sequence = typename make_index_sequence_impl<N>::type;
 
+    /**
+     * @brief Compile-time name of a type, as spelled by the compiler
+     */
+    template<typename T>
+    constexpr std::string_view type_name() noexcept {
+#if defined(_MSC_VER) && !defined(__clang__)
+        return __FUNCSIG__;
+#else
+        return __PRETTY_FUNCTION__;
+#endif
+    }
+
+    /**
+     * @brief FNV-1a hash step over a string
+     */
+    constexpr std::uint64_t fnv1a(std::string_view text, std::uint64_t hash = 0xcbf29ce484222325ull) noexcept {
+        for (char c : text) {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 0x100000001b3ull;
+        }
+        return hash;
+    }
+
+    /**
+     * @brief FNV-1a hash step over an integer
+     */
+    constexpr std::uint64_t fnv1a(std::uint64_t value, std::uint64_t hash) noexcept {
+        for (int i = 0; i < 8; ++i) {
+            hash ^= (value >> (i * 8)) & 0xFFu;
+            hash *= 0x100000001b3ull;
+        }
+        return hash;
+    }
+
+} // namespace detail
+
+namespace detail {
+    /**
+     * @brief Types that manage heap memory through an allocator (std::string, std::vector)
+     */
+    template<typename T>
+    concept allocating = requires { typename T::allocator_type; };
+    
+    /**
+     * @brief Smallest unsigned type holding values up to N
+     */
+    template<std::size_t N>
+    using capacity_t = std::conditional_t<(N <= 0xFFu), std::uint8_t,
+                       std::conditional_t<(N <= 0xFFFFu), std::uint16_t,
+                       std::conditional_t<(N <= 0xFFFFFFFFu), std::uint32_t, std::size_t>>>;
 } // namespace detail
 
 /**
  * @brief Concept for types that can be used as cell values
+ * 
+ * With FRP_NO_HEAP defined, allocator-aware types such as std::string and
+ * std::vector are rejected at compile time; use fixed_string and
+ * inline_vector instead.
  */
 template<typename T>
-concept CellValue = std::is_copy_constructible_v<T> && std::is_move_constructible_v<T>;
+concept CellValue = std::is_copy_constructible_v<T> && std::is_move_constructible_v<T>
+#ifdef FRP_NO_HEAP
+    && !detail::allocating<T>
+#endif
+    ;
 
 /**
  * @brief A cell represents a value that can change over time
@@ -224,6 +345,24 @@ public:
         value_ = std::move(new_value);
     }
     
+    /**
+     * @brief Modify the value in place, without copying it
+     * 
+     * @param f Called with a mutable reference to the value; returns whether
+     *        it changed anything (a void result counts as a change)
+     * @return true if f reported a change
+     */
+    template<typename F>
+        requires std::invocable<F&, T&>
+    constexpr bool modify(F&& f) {
+        if constexpr (std::is_void_v<std::invoke_result_t<F&, T&>>) {
+            f(value_);
+            return true;
+        } else {
+            return static_cast<bool>(f(value_));
+        }
+    }
+    
     /**
      * @brief Map function to transform the cell
      * 
@@ -238,6 +377,138 @@ public:
     }
 };
 
+/**
+ * @brief A cell whose value is fixed at compile time
+ * 
+ * Marks a graph input as a build-time constant (a threshold, a calibration
+ * offset). The cell is empty: its value is part of the type, so update
+ * functions reading it are specialized on the constant by the compiler, and
+ * it takes no storage in a ReactiveGraph. It has no set_value().
+ * 
+ * @tparam V Constant value
+ */
+template<auto V>
+    requires CellValue<decltype(V)>
+class ConstCell {
+public:
+    /**
+     * @brief Type of the value stored in the cell
+     */
+    using value_type = decltype(V);
+    
+private:
+    static constexpr value_type value_ = V;
+    
+public:
+    /**
+     * @brief Get the constant value of the cell
+     */
+    static constexpr const value_type& value() noexcept {
+        return value_;
+    }
+};
+
+/**
+ * @brief Check whether a graph element is a compile-time constant cell
+ */
+template<typename T>
+inline constexpr bool is_const_cell_v = false;
+
+template<auto V>
+inline constexpr bool is_const_cell_v<ConstCell<V>> = true;
+
+/**
+ * @brief Unit delay: the value cell I of the graph had at the end of the previous tick
+ * 
+ * Breaks feedback loops. An update function reading a delay instead of the
+ * cell itself does not depend on the cell's update in the same tick, so a
+ * loop such as plant -> measurement -> controller -> plant can be scheduled
+ * in one pass, with its state kept in the graph (and in its checkpoints).
+ * 
+ * @code
+ * using Graph = frp::ReactiveGraph<
+ *     frp::Cell<float>,          // 0: throttle
+ *     frp::Cell<float>,          // 1: motor power, rate limited
+ *     frp::delay<1, float>>;     // 2: motor power of the previous tick
+ * 
+ * graph.update_cell<1>([](const auto& cells) {
+ *     const float last = std::get<2>(cells).value();
+ *     return std::clamp(std::get<0>(cells).value() * 100.0f, last - 5.0f, last + 5.0f);
+ * });
+ * graph.advance_delays(); // end of tick; TickExecutor does this itself
+ * @endcode
+ * 
+ * The graph checks at compile time that I names a cell (not a signal or
+ * another delay) with value type T. Delays cannot be updated directly.
+ * 
+ * @tparam I Index of the delayed cell in the graph
+ * @tparam T Value type of that cell
+ */
+template<std::size_t I, CellValue T>
+class delay {
+private:
+    T value_;
+    
+    template<typename Layout, typename... Cells>
+    friend class BasicReactiveGraph;
+    
+    constexpr void latch(const T& value) {
+        value_ = value;
+    }
+    
+public:
+    /**
+     * @brief Type of the value stored in the delay
+     */
+    using value_type = T;
+    
+    /**
+     * @brief Index of the delayed cell
+     */
+    static constexpr std::size_t source = I;
+    
+    /**
+     * @brief Constructor with the value seen in the first tick
+     */
+    constexpr explicit delay(T initial_value = T{}) : value_(std::move(initial_value)) {}
+    
+    /**
+     * @brief Value of the delayed cell at the end of the previous tick
+     */
+    constexpr const T& value() const noexcept {
+        return value_;
+    }
+};
+
+/**
+ * @brief Check whether a graph element is a unit delay
+ */
+template<typename T>
+inline constexpr bool is_delay_v = false;
+
+template<std::size_t I, typename T>
+inline constexpr bool is_delay_v<delay<I, T>> = true;
+
+namespace detail {
+    template<auto F, typename... Deps>
+    struct fold_constants {
+        static_assert((is_const_cell_v<Deps> && ...), "Folded cells may only depend on constant cells");
+        using type = ConstCell<std::invoke(F, Deps::value()...)>;
+    };
+} // namespace detail
+
+/**
+ * @brief A node depending only on constant cells, evaluated at compile time
+ * 
+ * The result is itself a ConstCell, so folding propagates through chains of
+ * constant nodes and ReactiveGraph drops the node from the runtime schedule.
+ * 
+ * @tparam F Pure constexpr function (function pointer or captureless lambda)
+ * @tparam Deps ConstCell types passed to F, in order
+ */
+template<auto F, typename... Deps>
+using FoldedCell = typename detail::fold_constants<F, Deps...>::type;
+
 /**
  * @brief A behavior represents a function from time to values
  * 
@@ -258,6 +529,7 @@ public:
      * @brief Constructor with function
      */
     template<typename F>
+        requires std::is_invocable_r_v<T, const std::remove_cvref_t<F>&>
     constexpr explicit Behavior(F&& f) : function_(std::forward<F>(f)) {}
     
     /**
@@ -315,152 +587,2397 @@ constexpr auto lift(F&& f, const Bs&... bs) {
 }
 
 /**
- * @brief A reactive graph represents a network of cells and behaviors
+ * @brief String with a fixed capacity, stored inline
  * 
- * @tparam Cells Types of cells in the graph
+ * A payload type for text carried by cells and signals (alerts, labels)
+ * without heap allocation. Appending never allocates: text beyond the
+ * capacity is cut off and the append reports it. The characters are kept
+ * NUL-terminated, and the type is trivially copyable.
+ * 
+ * @tparam N Capacity in characters
  */
-template<typename... Cells>
-class ReactiveGraph {
+template<std::size_t N>
+class fixed_string {
 private:
-    std::tuple<Cells...> cells_;
+    std::array<char, N + 1> data_{};
+    detail::capacity_t<N> size_ = 0;
     
 public:
     /**
-     * @brief Constructor with cells
+     * @brief Empty string
      */
-    constexpr explicit ReactiveGraph(Cells... cells) 
-        : cells_(std::move(cells)...) {}
+    constexpr fixed_string() noexcept = default;
     
     /**
-     * @brief Get a cell from the graph
+     * @brief String from a literal that fits the capacity
+     */
+    template<std::size_t M>
+        requires (M - 1 <= N)
+    constexpr fixed_string(const char (&text)[M]) noexcept {
+        append(std::string_view(text, M - 1));
+    }
+    
+    /**
+     * @brief String from arbitrary text, cut off at the capacity
+     */
+    constexpr explicit fixed_string(std::string_view text) noexcept {
+        append(text);
+    }
+    
+    /**
+     * @brief Append text
      * 
-     * @tparam I Index of the cell
-     * @return Reference to the cell
+     * @return false if the text was cut off
      */
-    template<std::size_t I>
-    constexpr auto& get_cell() {
-        return std::get<I>(cells_);
+    constexpr bool append(std::string_view text) noexcept {
+        const std::size_t count = text.size() < N - size_ ? text.size() : N - size_;
+        for (std::size_t i = 0; i < count; ++i) {
+            data_[size_ + i] = text[i];
+        }
+        size_ = static_cast<detail::capacity_t<N>>(size_ + count);
+        data_[size_] = '\0';
+        return count == text.size();
     }
     
     /**
-     * @brief Get a cell from the graph (const version)
+     * @brief Append a character
      * 
-     * @tparam I Index of the cell
-     * @return Const reference to the cell
+     * @return false if the string is full
      */
-    template<std::size_t I>
-    constexpr const auto& get_cell() const {
-        return std::get<I>(cells_);
+    constexpr bool append(char c) noexcept {
+        return append(std::string_view(&c, 1));
     }
     
     /**
-     * @brief Update the graph based on dependencies
+     * @brief Append an integer in decimal
      * 
-     * @tparam Deps Dependency indices
-     * @param update_functions Functions to update cells
+     * @return false (and nothing appended) if the digits do not fit
      */
-    template<std::size_t... Deps, typename... Fs>
-    constexpr void update(detail::index_sequence<Deps...>, Fs&&... update_functions) {
-        (update_cell<Deps>(std::forward<Fs>(update_functions)), ...);
+    template<typename T>
+        requires (std::is_integral_v<T> && !std::is_same_v<T, bool> && !std::is_same_v<T, char>)
+    bool append(T value) noexcept {
+        const auto result = std::to_chars(data_.data() + size_, data_.data() + N, value);
+        return commit(result);
     }
     
     /**
-     * @brief Update a specific cell
+     * @brief Append a floating-point number
      * 
-     * @tparam I Index of the cell to update
-     * @param f Function to compute the new value
+     * @param precision Digits after the decimal point; negative for the
+     *        shortest text that reads back as the same value
+     * @return false (and nothing appended) if the digits do not fit
      */
-    template<std::size_t I, typename F>
-    constexpr void update_cell(F&& f) {
-        auto& cell = std::get<I>(cells_);
-        cell.set_value(f(cells_));
+    template<typename T>
+        requires std::is_floating_point_v<T>
+    bool append(T value, int precision = -1) noexcept {
+        const auto result = precision < 0
+            ? std::to_chars(data_.data() + size_, data_.data() + N, value)
+            : std::to_chars(data_.data() + size_, data_.data() + N, value, std::chars_format::fixed, precision);
+        return commit(result);
+    }
+    
+    /**
+     * @brief Append text or a character, cut off at the capacity
+     */
+    constexpr fixed_string& operator+=(std::string_view text) noexcept {
+        append(text);
+        return *this;
+    }
+    
+    constexpr fixed_string& operator+=(char c) noexcept {
+        append(c);
+        return *this;
+    }
+    
+    /**
+     * @brief Remove all characters
+     */
+    constexpr void clear() noexcept {
+        size_ = 0;
+        data_[0] = '\0';
+    }
+    
+    constexpr std::size_t size() const noexcept {
+        return size_;
+    }
+    
+    constexpr bool empty() const noexcept {
+        return size_ == 0;
+    }
+    
+    static constexpr std::size_t capacity() noexcept {
+        return N;
+    }
+    
+    /**
+     * @brief NUL-terminated characters
+     */
+    constexpr const char* c_str() const noexcept {
+        return data_.data();
+    }
+    
+    constexpr std::string_view view() const noexcept {
+        return std::string_view(data_.data(), size_);
+    }
+    
+    constexpr operator std::string_view() const noexcept {
+        return view();
+    }
+    
+    friend constexpr bool operator==(const fixed_string& a, std::string_view b) noexcept {
+        return a.view() == b;
+    }
+    
+private:
+    bool commit(std::to_chars_result result) noexcept {
+        if (result.ec != std::errc{}) {
+            data_[size_] = '\0';
+            return false;
+        }
+        size_ = static_cast<detail::capacity_t<N>>(result.ptr - data_.data());
+        data_[size_] = '\0';
+        return true;
     }
 };
 
 /**
- * @brief Create a reactive graph from cells
+ * @brief Vector with a fixed capacity, stored inline
  * 
- * @tparam Cells Types of cells
- * @param cells Cells to include in the graph
- * @return A new reactive graph
- */
-template<typename... Cells>
-constexpr auto make_graph(Cells... cells) {
-    return ReactiveGraph<Cells...>(std::move(cells)...);
-}
-
-/**
- * @brief A signal represents a discrete event with a value
+ * A payload type for variable-length sequences (samples of a burst, ids of
+ * active faults) without heap allocation. All N elements are always
+ * constructed; the type is trivially copyable when T is, so it can be
+ * checkpointed and published byte-wise.
  * 
- * @tparam T Type of the value carried by the signal
+ * @tparam T Element type (default constructible)
+ * @tparam N Capacity in elements
  */
-template<CellValue T>
-class Signal {
+template<typename T, std::size_t N>
+    requires std::is_default_constructible_v<T> && CellValue<T>
+class inline_vector {
 private:
-    T value_;
-    bool occurred_;
+    std::array<T, N> items_{};
+    detail::capacity_t<N> size_ = 0;
     
 public:
-    /**
-     * @brief Type of the value carried by the signal
-     */
     using value_type = T;
+    using iterator = T*;
+    using const_iterator = const T*;
     
     /**
-     * @brief Default constructor
+     * @brief Empty vector
      */
-    constexpr Signal() : value_{}, occurred_(false) {}
+    constexpr inline_vector() = default;
     
     /**
-     * @brief Constructor with value
+     * @brief Vector holding the first N values of a list
      */
-    constexpr explicit Signal(T value) : value_(std::move(value)), occurred_(true) {}
+    constexpr inline_vector(std::initializer_list<T> values) {
+        for (const T& value : values) {
+            if (!push_back(value)) {
+                break;
+            }
+        }
+    }
     
     /**
-     * @brief Check if the signal occurred
+     * @brief Append an element
+     * 
+     * @return false (and nothing appended) if the vector is full
      */
-    constexpr bool occurred() const noexcept {
-        return occurred_;
+    constexpr bool push_back(T value) {
+        if (size_ == N) {
+            return false;
+        }
+        items_[size_] = std::move(value);
+        ++size_;
+        return true;
     }
     
     /**
-     * @brief Get the value of the signal
+     * @brief Remove the last element (no-op when empty)
      */
-    constexpr const T& value() const noexcept {
-        return value_;
+    constexpr void pop_back() {
+        if (size_ > 0) {
+            --size_;
+            items_[size_] = T{};
+        }
     }
     
     /**
-     * @brief Reset the signal
+     * @brief Remove all elements
      */
-    constexpr void reset() noexcept {
-        occurred_ = false;
+    constexpr void clear() {
+        for (std::size_t i = 0; i < size_; ++i) {
+            items_[i] = T{};
+        }
+        size_ = 0;
     }
     
-    /**
-     * @brief Fire the signal with a value
-     */
-    constexpr void fire(T new_value) {
-        value_ = std::move(new_value);
-        occurred_ = true;
+    constexpr T& operator[](std::size_t i) noexcept {
+        return items_[i];
     }
     
-    /**
-     * @brief Map function to transform the signal
-     * 
-     * @tparam F Function type
-     * @param f Function to apply to the signal value
-     * @return A new signal with the transformed value
-     */
-    template<typename F>
-    constexpr auto map(F&& f) const {
-        using R = std::invoke_result_t<F, T>;
-        if (occurred_) {
-            return Signal<R>(f(value_));
-        } else {
+    constexpr const T& operator[](std::size_t i) const noexcept {
+        return items_[i];
+    }
+    
+    constexpr T& back() noexcept {
+        return items_[size_ - 1];
+    }
+    
+    constexpr const T& back() const noexcept {
+        return items_[size_ - 1];
+    }
+    
+    constexpr std::size_t size() const noexcept {
+        return size_;
+    }
+    
+    constexpr bool empty() const noexcept {
+        return size_ == 0;
+    }
+    
+    constexpr bool full() const noexcept {
+        return size_ == N;
+    }
+    
+    static constexpr std::size_t capacity() noexcept {
+        return N;
+    }
+    
+    constexpr T* data() noexcept {
+        return items_.data();
+    }
+    
+    constexpr const T* data() const noexcept {
+        return items_.data();
+    }
+    
+    constexpr iterator begin() noexcept {
+        return items_.data();
+    }
+    
+    constexpr iterator end() noexcept {
+        return items_.data() + size_;
+    }
+    
+    constexpr const_iterator begin() const noexcept {
+        return items_.data();
+    }
+    
+    constexpr const_iterator end() const noexcept {
+        return items_.data() + size_;
+    }
+    
+    friend constexpr bool operator==(const inline_vector& a, const inline_vector& b) {
+        if (a.size_ != b.size_) {
+            return false;
+        }
+        for (std::size_t i = 0; i < a.size_; ++i) {
+            if (!(a.items_[i] == b.items_[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+/**
+ * @brief Integer domain [Min, Max] of a lookup table
+ * 
+ * Every value of the domain has its own table entry.
+ * 
+ * @tparam Min Smallest input value
+ * @tparam Max Largest input value
+ */
+template<auto Min, auto Max>
+    requires (std::is_integral_v<decltype(Min)> && std::is_same_v<decltype(Min), decltype(Max)> && Min <= Max)
+struct lut_domain {
+    using value_type = decltype(Min);
+    static constexpr value_type min = Min;
+    static constexpr value_type max = Max;
+    static constexpr std::size_t size = static_cast<std::size_t>(Max - Min) + 1;
+    
+    static constexpr value_type point(std::size_t i) noexcept {
+        return static_cast<value_type>(Min + static_cast<value_type>(i));
+    }
+};
+
+/**
+ * @brief Floating-point domain [Min, Max] of a lookup table
+ * 
+ * The function is sampled at Points equally spaced points; lookups between
+ * two points interpolate linearly.
+ * 
+ * @tparam Min Smallest input value
+ * @tparam Max Largest input value
+ * @tparam Points Number of sample points (at least 2)
+ */
+template<auto Min, auto Max, std::size_t Points>
+    requires (std::is_floating_point_v<decltype(Min)> && std::is_same_v<decltype(Min), decltype(Max)> &&
+              Min < Max && Points >= 2)
+struct lut_interpolated {
+    using value_type = decltype(Min);
+    static constexpr value_type min = Min;
+    static constexpr value_type max = Max;
+    static constexpr std::size_t size = Points;
+    static constexpr value_type step = (Max - Min) / static_cast<value_type>(Points - 1);
+    
+    static constexpr value_type point(std::size_t i) noexcept {
+        return i + 1 == Points ? Max : Min + step * static_cast<value_type>(i);
+    }
+};
+
+/**
+ * @brief Pure node function replaced by a table computed at compile time
+ * 
+ * F is evaluated over the whole domain during compilation into a
+ * `constexpr std::array`; calling the node is then a table lookup (plus a
+ * linear interpolation for floating-point domains). Inputs outside the domain
+ * are clamped to it.
+ * 
+ * @tparam F Constexpr-evaluable function of one argument (function pointer or captureless lambda)
+ * @tparam Domain lut_domain or lut_interpolated describing the inputs
+ */
+template<auto F, typename Domain>
+class lut_node {
+public:
+    /**
+     * @brief Type of the input value
+     */
+    using argument_type = typename Domain::value_type;
+    
+    /**
+     * @brief Type of the tabulated result
+     */
+    using value_type = std::remove_cvref_t<std::invoke_result_t<decltype(F), argument_type>>;
+    
+    static_assert(std::is_integral_v<argument_type> || std::is_arithmetic_v<value_type>,
+                  "Interpolated lookup tables need arithmetic results");
+    
+    /**
+     * @brief The function evaluated at every point of the domain
+     */
+    static constexpr std::array<value_type, Domain::size> table = [] {
+        std::array<value_type, Domain::size> result{};
+        for (std::size_t i = 0; i < Domain::size; ++i) {
+            result[i] = std::invoke(F, Domain::point(i));
+        }
+        return result;
+    }();
+    
+    /**
+     * @brief Look up the function value for an input
+     */
+    static constexpr value_type lookup(argument_type x) noexcept {
+        if (!(x > Domain::min)) {
+            return table.front();
+        }
+        if (!(x < Domain::max)) {
+            return table.back();
+        }
+        if constexpr (std::is_integral_v<argument_type>) {
+            return table[static_cast<std::size_t>(x - Domain::min)];
+        } else {
+            const argument_type pos = (x - Domain::min) / Domain::step;
+            std::size_t i = static_cast<std::size_t>(pos);
+            if (i >= Domain::size - 1) {
+                i = Domain::size - 2;
+            }
+            const argument_type frac = pos - static_cast<argument_type>(i);
+            return table[i] + (table[i + 1] - table[i]) * frac;
+        }
+    }
+    
+    /**
+     * @brief Call the node like the function it replaces
+     */
+    constexpr value_type operator()(argument_type x) const noexcept {
+        return lookup(x);
+    }
+};
+
+namespace detail {
+    /**
+     * @brief Result and argument types of a function pointer or function object
+     */
+    template<typename F>
+    struct callable_signature : callable_signature<decltype(&F::operator())> {};
+
+    template<typename R, typename... Args>
+    struct callable_signature<R (*)(Args...)> {
+        using result_type = std::remove_cvref_t<R>;
+        using key_type = std::tuple<std::remove_cvref_t<Args>...>;
+        using arguments = std::tuple<Args...>;
+    };
+
+    template<typename R, typename C, typename... Args>
+    struct callable_signature<R (C::*)(Args...) const> : callable_signature<R (*)(Args...)> {};
+
+    template<typename R, typename... Args>
+    struct callable_signature<R (*)(Args...) noexcept> : callable_signature<R (*)(Args...)> {};
+
+    template<typename R, typename C, typename... Args>
+    struct callable_signature<R (C::*)(Args...) const noexcept> : callable_signature<R (*)(Args...)> {};
+
+    /**
+     * @brief Types whose bytes can be hashed and compared to find equal values again
+     */
+    template<typename T>
+    concept memo_key = std::is_trivially_copyable_v<T> &&
+                       (std::has_unique_object_representations_v<T> || std::is_floating_point_v<T>);
+
+    /**
+     * @brief Hash the object representations of a set of arguments
+     */
+    template<typename... Ts>
+    std::uint64_t memo_hash(const Ts&... values) noexcept {
+        std::uint64_t hash = 0xcbf29ce484222325ull;
+        ((hash = fnv1a(std::string_view(reinterpret_cast<const char*>(&values), sizeof(Ts)), hash)), ...);
+        // Fibonacci hashing spreads the low-entropy FNV tail over the high bits
+        return hash * 0x9E3779B97F4A7C15ull;
+    }
+
+    /**
+     * @brief Compare a stored key with a set of arguments byte by byte
+     * 
+     * Matches the hash: unlike ==, this tells -0.0 from 0.0, whose results
+     * may differ (1/x), and finds a NaN argument again.
+     */
+    template<typename Key, typename... Ts>
+    bool memo_equal(const Key& key, const Ts&... values) noexcept {
+        return [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+            return ((std::memcmp(&std::get<Is>(key), &values, sizeof(Ts)) == 0) && ...);
+        }(std::index_sequence_for<Ts...>{});
+    }
+} // namespace detail
+
+/**
+ * @brief Pure node function with a direct-mapped result cache
+ * 
+ * Each call hashes the arguments to one cache entry; if the entry holds the
+ * same arguments the stored result is returned, otherwise F is evaluated and
+ * the entry is overwritten. The cache lives in static storage, one per
+ * instantiation, and is not synchronized: use a memo_node from one thread.
+ * 
+ * @tparam F Pure function (function pointer or captureless lambda)
+ * @tparam Entries Number of cache entries (power of two)
+ */
+template<auto F, std::size_t Entries = 256>
+class memo_node {
+private:
+    using signature = detail::callable_signature<decltype(F)>;
+    
+    static_assert(Entries > 0 && (Entries & (Entries - 1)) == 0, "Cache size must be a power of two");
+    
+public:
+    /**
+     * @brief Type of the cached result
+     */
+    using value_type = typename signature::result_type;
+    
+private:
+    using key_type = typename signature::key_type;
+    
+    struct entry {
+        key_type key{};
+        value_type value{};
+        bool valid = false;
+    };
+    
+    static constexpr unsigned index_bits = static_cast<unsigned>(std::countr_zero(Entries));
+    
+    static inline std::array<entry, Entries> cache_{};
+    static inline std::uint64_t hits_ = 0;
+    static inline std::uint64_t misses_ = 0;
+    
+    template<typename... Args>
+    static value_type call_impl(const Args&... args) {
+        static_assert((detail::memo_key<Args> && ...), "Memoized arguments must be trivially copyable and hashable");
+        
+        std::size_t index = 0;
+        if constexpr (index_bits > 0) {
+            index = static_cast<std::size_t>(detail::memo_hash(args...) >> (64 - index_bits));
+        }
+        entry& e = cache_[index];
+        if (e.valid && detail::memo_equal(e.key, args...)) {
+            ++hits_;
+            return e.value;
+        }
+        ++misses_;
+        e.value = std::invoke(F, args...);
+        e.key = key_type(args...);
+        e.valid = true;
+        return e.value;
+    }
+    
+public:
+    /**
+     * @brief Call F through the cache
+     */
+    template<typename... Args>
+        requires std::is_invocable_v<decltype(F), const Args&...>
+    static value_type call(const Args&... args) {
+        return [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+            return call_impl(static_cast<const std::tuple_element_t<Is, key_type>&>(args)...);
+        }(std::index_sequence_for<Args...>{});
+    }
+    
+    /**
+     * @brief Call the node like the function it wraps
+     */
+    template<typename... Args>
+    value_type operator()(const Args&... args) const {
+        return call(args...);
+    }
+    
+    /**
+     * @brief Bytes of static storage used by the cache and its counters
+     */
+    static constexpr std::size_t static_bytes = sizeof(cache_) + sizeof(hits_) + sizeof(misses_);
+    
+    /**
+     * @brief Number of calls answered from the cache
+     */
+    static std::uint64_t hits() noexcept {
+        return hits_;
+    }
+    
+    /**
+     * @brief Number of calls that evaluated F
+     */
+    static std::uint64_t misses() noexcept {
+        return misses_;
+    }
+    
+    /**
+     * @brief Invalidate every entry and clear the counters
+     */
+    static void reset() noexcept {
+        for (entry& e : cache_) {
+            e.valid = false;
+        }
+        hits_ = 0;
+        misses_ = 0;
+    }
+};
+
+template<CellValue T>
+class Signal;
+
+template<typename T>
+class SignalView;
+
+namespace detail {
+    /**
+     * @brief Whether a value holds a memory address (pointer, span, view)
+     * 
+     * Copied byte-wise into a checkpoint, such a value would restore as a
+     * dangling address after a restart.
+     */
+    template<typename T>
+    struct holds_address : std::bool_constant<std::is_pointer_v<T>> {};
+
+    template<typename T, std::size_t N>
+    struct holds_address<std::span<T, N>> : std::true_type {};
+
+    template<typename C, typename Traits>
+    struct holds_address<std::basic_string_view<C, Traits>> : std::true_type {};
+
+    template<typename T>
+    struct holds_address<SignalView<T>> : std::true_type {};
+
+    template<typename T, std::size_t N>
+    struct holds_address<std::array<T, N>> : holds_address<T> {};
+
+    template<typename T>
+    struct holds_address<Cell<T>> : holds_address<T> {};
+
+    template<typename T>
+    struct holds_address<Signal<T>> : holds_address<T> {};
+
+    template<std::size_t I, typename T>
+    struct holds_address<delay<I, T>> : holds_address<T> {};
+} // namespace detail
+
+/**
+ * @brief Customization point describing how a graph element is checkpointed
+ * 
+ * Trivially copyable elements (e.g. Cell<float>, Signal<int>) are copied
+ * byte-wise and need no specialization, unless they hold addresses
+ * (pointers, spans, string views): those would dangle after a restart, so
+ * they are rejected unless a specialization saves them in a stable form,
+ * e.g. as an index into a static table. Stateful operators holding other
+ * types specialize this template with:
+ * - `static constexpr std::size_t size` - bytes the element occupies in an image
+ * - `static void save(const T&, std::byte*)` - write the element's state
+ * - `static void load(T&, const std::byte*)` - read the element's state back
+ * 
+ * @tparam T Type of the graph element
+ */
+template<typename T>
+struct checkpoint_traits {
+    static constexpr bool specialized = false;
+};
+
+/**
+ * @brief Constant cells carry no state; their value is covered by the topology hash
+ */
+template<auto V>
+struct checkpoint_traits<ConstCell<V>> {
+    static constexpr std::size_t size = 0;
+    static void save(const ConstCell<V>&, std::byte*) noexcept {}
+    static void load(ConstCell<V>&, const std::byte*) noexcept {}
+};
+
+/**
+ * @brief Concept for graph elements that can be written to a checkpoint image
+ */
+template<typename T>
+concept Checkpointable = (std::is_trivially_copyable_v<T> && !detail::holds_address<T>::value) ||
+                         requires(T& t, const T& ct, std::byte* out, const std::byte* in) {
+    { checkpoint_traits<T>::size } -> std::convertible_to<std::size_t>;
+    checkpoint_traits<T>::save(ct, out);
+    checkpoint_traits<T>::load(t, in);
+};
+
+/**
+ * @brief Header at the start of every checkpoint image
+ */
+struct CheckpointHeader {
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::uint64_t topology_hash;
+    std::uint64_t payload_size;
+
+    static constexpr std::uint32_t expected_magic = 0x43505246u; // "FRPC"
+    static constexpr std::uint32_t current_version = 2; ///< 2: packed flag bitset before the payloads
+};
+
+namespace detail {
+    /**
+     * @brief Bytes an element occupies in a checkpoint image
+     */
+    template<Checkpointable T>
+    constexpr std::size_t checkpoint_size_of() noexcept {
+        if constexpr (requires { checkpoint_traits<T>::size; }) {
+            return checkpoint_traits<T>::size;
+        } else {
+            return sizeof(T);
+        }
+    }
+
+    template<Checkpointable T>
+    void checkpoint_save(const T& element, std::byte* out) {
+        if constexpr (requires { checkpoint_traits<T>::size; }) {
+            checkpoint_traits<T>::save(element, out);
+        } else {
+            std::memcpy(out, &element, sizeof(T));
+        }
+    }
+
+    template<Checkpointable T>
+    void checkpoint_load(T& element, const std::byte* in) {
+        if constexpr (requires { checkpoint_traits<T>::size; }) {
+            checkpoint_traits<T>::load(element, in);
+        } else {
+            std::memcpy(&element, in, sizeof(T));
+        }
+    }
+} // namespace detail
+
+namespace detail {
+    /**
+     * @brief Smallest unsigned word holding Bits flags; 64-bit words beyond that
+     */
+    template<std::size_t Bits>
+    using bit_word_t = std::conditional_t<(Bits <= 8), std::uint8_t,
+                       std::conditional_t<(Bits <= 16), std::uint16_t,
+                       std::conditional_t<(Bits <= 32), std::uint32_t, std::uint64_t>>>;
+
+    /**
+     * @brief How a graph element is stored by ReactiveGraph
+     * 
+     * Packed elements keep one flag bit in the graph's bitset (the value of a
+     * Cell<bool>, the occurrence flag of a Signal); `payload` is what remains
+     * in the element tuple, or void if nothing does.
+     */
+    template<typename T>
+    struct packing {
+        static constexpr bool packed = false;
+        using payload = T;
+    };
+
+    template<>
+    struct packing<Cell<bool>> {
+        static constexpr bool packed = true;
+        using payload = void;
+    };
+
+    template<typename T>
+    struct packing<Signal<T>> {
+        static constexpr bool packed = true;
+        using payload = T;
+    };
+
+    /**
+     * @brief Flag storage of a graph without packed elements
+     */
+    struct no_flags {};
+
+    template<typename T>
+    using payload_tuple_t = std::conditional_t<std::is_void_v<typename packing<T>::payload>,
+                                               std::tuple<>, std::tuple<typename packing<T>::payload>>;
+
+    /**
+     * @brief Check that a delay among the elements of a graph names a delayable cell
+     */
+    template<typename E, typename Elements>
+    constexpr bool delay_fits() {
+        if constexpr (!is_delay_v<E>) {
+            return true;
+        } else if constexpr (E::source >= std::tuple_size_v<Elements>) {
+            return false;
+        } else {
+            using S = std::tuple_element_t<E::source, Elements>;
+            return !is_delay_v<S> && !(packing<S>::packed && !std::is_same_v<S, Cell<bool>>) &&
+                   std::is_same_v<typename S::value_type, typename E::value_type>;
+        }
+    }
+
+    /**
+     * @brief Flag bit of a packed element
+     */
+    constexpr bool packed_flag(const Cell<bool>& cell) noexcept {
+        return cell.value();
+    }
+
+    template<typename T>
+    constexpr bool packed_flag(const Signal<T>& signal) noexcept {
+        return signal.occurred();
+    }
+
+    /**
+     * @brief Part of an element that stays in the element tuple
+     */
+    template<typename T>
+    constexpr payload_tuple_t<T> pack_payload(T element) {
+        if constexpr (!packing<T>::packed) {
+            return payload_tuple_t<T>(std::move(element));
+        } else if constexpr (std::is_void_v<typename packing<T>::payload>) {
+            return {};
+        } else {
+            return payload_tuple_t<T>(element.value());
+        }
+    }
+
+    /**
+     * @brief Boolean cell stored as one bit of a graph's bitset
+     * 
+     * Returned by ReactiveGraph::get_cell() in place of a Cell<bool>&.
+     */
+    template<typename Word, bool Const>
+    class packed_bool_cell {
+    private:
+        std::conditional_t<Const, const Word*, Word*> word_;
+        Word mask_;
+        
+    public:
+        using value_type = bool;
+        
+        constexpr packed_bool_cell(std::conditional_t<Const, const Word*, Word*> word, Word mask) noexcept
+            : word_(word), mask_(mask) {}
+        
+        constexpr bool value() const noexcept {
+            return (*word_ & mask_) != 0;
+        }
+        
+        constexpr void set_value(bool new_value) noexcept requires (!Const) {
+            if (new_value) {
+                *word_ = static_cast<Word>(*word_ | mask_);
+            } else {
+                *word_ = static_cast<Word>(*word_ & ~mask_);
+            }
+        }
+        
+        template<typename F>
+            requires (!Const && std::invocable<F&, bool&>)
+        constexpr bool modify(F&& f) {
+            bool bit = value();
+            bool changed = true;
+            if constexpr (std::is_void_v<std::invoke_result_t<F&, bool&>>) {
+                f(bit);
+            } else {
+                changed = static_cast<bool>(f(bit));
+            }
+            set_value(bit);
+            return changed;
+        }
+        
+        template<typename F>
+        constexpr auto map(F&& f) const {
+            using R = std::invoke_result_t<F, bool>;
+            return Cell<R>(f(value()));
+        }
+    };
+
+    /**
+     * @brief Signal whose occurrence flag is one bit of a graph's bitset
+     * 
+     * Returned by ReactiveGraph::get_cell() in place of a Signal<T>&.
+     */
+    template<typename T, typename Word, bool Const>
+    class packed_signal {
+    private:
+        std::conditional_t<Const, const T*, T*> value_;
+        std::conditional_t<Const, const Word*, Word*> word_;
+        Word mask_;
+        
+    public:
+        using value_type = T;
+        
+        constexpr packed_signal(std::conditional_t<Const, const T*, T*> value,
+                                std::conditional_t<Const, const Word*, Word*> word, Word mask) noexcept
+            : value_(value), word_(word), mask_(mask) {}
+        
+        constexpr bool occurred() const noexcept {
+            return (*word_ & mask_) != 0;
+        }
+        
+        constexpr const T& value() const noexcept {
+            return *value_;
+        }
+        
+        constexpr void reset() noexcept requires (!Const) {
+            *word_ = static_cast<Word>(*word_ & ~mask_);
+        }
+        
+        constexpr void fire(T new_value) requires (!Const) {
+            *value_ = std::move(new_value);
+            *word_ = static_cast<Word>(*word_ | mask_);
+        }
+        
+        template<typename F>
+        constexpr auto map(F&& f) const {
+            using R = std::remove_cvref_t<std::invoke_result_t<F&, const T&>>;
+            return occurred() ? Signal<R>(f(value())) : Signal<R>();
+        }
+        
+        /**
+         * @brief Copy out as a standalone signal, e.g. for Sink::process()
+         */
+        constexpr operator Signal<T>() const {
+            return occurred() ? Signal<T>(*value_) : Signal<T>();
+        }
+        
+        /**
+         * @brief View of the signal, without copying the value
+         */
+        constexpr SignalView<T> view() const noexcept {
+            return SignalView<T>(occurred() ? value_ : nullptr);
+        }
+    };
+
+    /**
+     * @brief One element of ordered_storage
+     */
+    template<std::size_t K, typename T>
+    struct storage_leaf {
+        [[no_unique_address]] T value;
+        
+        constexpr explicit storage_leaf(T&& initial) : value(std::move(initial)) {}
+    };
+
+    /**
+     * @brief Element storage laid out in the order of its type arguments
+     * 
+     * Unlike std::tuple, elements are placed at increasing addresses in the
+     * order given, each at the next offset suitable for its own alignment, so
+     * a layout policy controls both padding and locality. Empty elements
+     * (e.g. ConstCell) take no space.
+     */
+    template<typename Indices, typename... Ts>
+    struct ordered_storage;
+
+    template<std::size_t... Ks, typename... Ts>
+    struct ordered_storage<std::index_sequence<Ks...>, Ts...> : storage_leaf<Ks, Ts>... {
+        template<typename Tuple, std::size_t... Sources>
+        constexpr ordered_storage(Tuple&& elements, std::index_sequence<Sources...>)
+            : storage_leaf<Ks, Ts>(std::get<Sources>(std::move(elements)))... {}
+    };
+
+    template<std::size_t K, typename T>
+    constexpr T& storage_get(storage_leaf<K, T>& leaf) noexcept {
+        return leaf.value;
+    }
+
+    template<std::size_t K, typename T>
+    constexpr const T& storage_get(const storage_leaf<K, T>& leaf) noexcept {
+        return leaf.value;
+    }
+} // namespace detail
+
+/**
+ * @brief Size, alignment and position of a stored graph element
+ * 
+ * Input of layout policies; `element` is the index used with get_cell().
+ */
+struct layout_entry {
+    std::size_t element;
+    std::size_t size;
+    std::size_t alignment;
+};
+
+namespace detail {
+    /**
+     * @brief Stable insertion sort of storage positions by a strict ordering
+     */
+    template<std::size_t N, typename Less>
+    constexpr std::array<std::size_t, N> sorted_order(const std::array<layout_entry, N>& entries, Less less) {
+        std::array<std::size_t, N> order{};
+        for (std::size_t i = 0; i < N; ++i) {
+            order[i] = i;
+        }
+        for (std::size_t i = 1; i < N; ++i) {
+            std::size_t current = order[i];
+            std::size_t j = i;
+            while (j > 0 && less(entries[current], entries[order[j - 1]])) {
+                order[j] = order[j - 1];
+                --j;
+            }
+            order[j] = current;
+        }
+        return order;
+    }
+} // namespace detail
+
+/**
+ * @brief Layout policy: store elements in declaration order
+ */
+struct declaration_order {
+    template<std::size_t N>
+    static constexpr std::array<std::size_t, N> order(const std::array<layout_entry, N>& entries) {
+        return detail::sorted_order(entries, [](const layout_entry&, const layout_entry&) { return false; });
+    }
+};
+
+/**
+ * @brief Layout policy: store elements by decreasing alignment
+ * 
+ * Removes all padding between elements; elements with equal alignment keep
+ * their declaration order. This is the default layout of ReactiveGraph.
+ */
+struct by_alignment {
+    template<std::size_t N>
+    static constexpr std::array<std::size_t, N> order(const std::array<layout_entry, N>& entries) {
+        return detail::sorted_order(entries, [](const layout_entry& a, const layout_entry& b) {
+            return a.alignment > b.alignment;
+        });
+    }
+};
+
+/**
+ * @brief Layout policy: store frequently accessed elements first
+ * 
+ * Elements are grouped by decreasing heat and sorted by alignment within a
+ * group, so the working set of a tick is packed into the first cache lines
+ * without padding between hot elements.
+ * 
+ * @tparam Heat Access frequency of each graph element, by get_cell() index
+ */
+template<std::size_t... Heat>
+struct by_hotness {
+    template<std::size_t N>
+    static constexpr std::array<std::size_t, N> order(const std::array<layout_entry, N>& entries) {
+        constexpr std::array<std::size_t, sizeof...(Heat)> heat{Heat...};
+        return detail::sorted_order(entries, [&heat](const layout_entry& a, const layout_entry& b) {
+            if (heat[a.element] != heat[b.element]) {
+                return heat[a.element] > heat[b.element];
+            }
+            return a.alignment > b.alignment;
+        });
+    }
+};
+
+/**
+ * @brief Layout policy: store elements in a given order
+ * 
+ * Typically generated from an access profile (see frp_layout_profile.hpp).
+ * Elements not listed follow the listed ones in declaration order.
+ * 
+ * @tparam Order Element indices (get_cell() indices) in storage order
+ */
+template<std::size_t... Order>
+struct explicit_layout {
+    template<std::size_t N>
+    static constexpr std::array<std::size_t, N> order(const std::array<layout_entry, N>& entries) {
+        constexpr std::array<std::size_t, sizeof...(Order)> listed{Order...};
+        auto rank = [&listed](const layout_entry& e) {
+            for (std::size_t i = 0; i < listed.size(); ++i) {
+                if (listed[i] == e.element) {
+                    return i;
+                }
+            }
+            return listed.size() + e.element;
+        };
+        return detail::sorted_order(entries, [&rank](const layout_entry& a, const layout_entry& b) {
+            return rank(a) < rank(b);
+        });
+    }
+};
+
+/**
+ * @brief Layout policy that reports every cell access to a profile
+ * 
+ * Graphs using it pass recording proxies to update functions and report
+ * get_cell() calls, so an instrumented run can learn which cells are used
+ * together. Storage follows Base. Intended for profiling builds only.
+ * 
+ * @tparam Profile Type with `static void record(std::size_t element)`
+ * @tparam Base Layout policy used for storage
+ */
+template<typename Profile, typename Base = by_alignment>
+struct profiled_layout : Base {
+    static void record_access(std::size_t element) noexcept {
+        Profile::record(element);
+    }
+};
+
+namespace detail {
+    template<typename Layout>
+    concept profiling_layout = requires(std::size_t element) { Layout::record_access(element); };
+
+    /**
+     * @brief Cell handed to update functions by a profiling graph; reads are recorded
+     */
+    template<typename Layout, std::size_t I, typename Ref>
+    class recorded_cell {
+    private:
+        Ref ref_;
+        
+    public:
+        constexpr recorded_cell(Ref ref) noexcept : ref_(ref) {}
+        
+        constexpr decltype(auto) value() const {
+            Layout::record_access(I);
+            return ref_.value();
+        }
+        
+        constexpr bool occurred() const
+            requires requires(const std::remove_reference_t<Ref>& r) { r.occurred(); } {
+            Layout::record_access(I);
+            return ref_.occurred();
+        }
+        
+        constexpr auto view() const
+            requires requires(const std::remove_reference_t<Ref>& r) { r.view(); } {
+            Layout::record_access(I);
+            return ref_.view();
+        }
+    };
+} // namespace detail
+
+/**
+ * @brief Static memory used by an object, split by purpose
+ */
+struct memory_usage {
+    std::size_t values = 0;    ///< Cell values, signal payloads and other state
+    std::size_t functions = 0; ///< Callable buffers of static_function wrappers
+    std::size_t metadata = 0;  ///< Flags, function pointers and padding
+    std::size_t external = 0;  ///< Static storage outside the object (tables, caches, mapped queues)
+    
+    /**
+     * @brief Bytes inside the object (what sizeof reports)
+     */
+    constexpr std::size_t object() const noexcept {
+        return values + functions + metadata;
+    }
+    
+    /**
+     * @brief All bytes, inside the object and outside
+     */
+    constexpr std::size_t total() const noexcept {
+        return object() + external;
+    }
+    
+    constexpr memory_usage& operator+=(const memory_usage& other) noexcept {
+        values += other.values;
+        functions += other.functions;
+        metadata += other.metadata;
+        external += other.external;
+        return *this;
+    }
+    
+    friend constexpr memory_usage operator+(memory_usage a, const memory_usage& b) noexcept {
+        return a += b;
+    }
+};
+
+/**
+ * @brief Customization point describing the static memory of a type
+ * 
+ * The default counts the object as plain values (empty types take nothing).
+ * Types holding callables or owning storage elsewhere specialize it with a
+ * `static constexpr memory_usage usage`.
+ * 
+ * @tparam T Type of a graph element, sink, adapter or graph
+ */
+template<typename T>
+struct memory_traits {
+    static constexpr memory_usage usage{std::is_empty_v<T> ? 0 : sizeof(T), 0, 0, 0};
+};
+
+template<CellValue T>
+struct memory_traits<Behavior<T>> {
+    static constexpr memory_usage usage{0, detail::static_function<T()>::buffer_size,
+                                        sizeof(Behavior<T>) - detail::static_function<T()>::buffer_size, 0};
+};
+
+template<auto F, typename Domain>
+struct memory_traits<lut_node<F, Domain>> {
+    static constexpr memory_usage usage{0, 0, 0, sizeof(lut_node<F, Domain>::table)};
+};
+
+template<auto F, std::size_t Entries>
+struct memory_traits<memo_node<F, Entries>> {
+    static constexpr memory_usage usage{0, 0, 0, memo_node<F, Entries>::static_bytes};
+};
+
+/**
+ * @brief Combined static memory of several objects (a graph, its sinks, adapters)
+ */
+template<typename... Ts>
+inline constexpr memory_usage memory_footprint_v = (memory_usage{} + ... + memory_traits<Ts>::usage);
+
+/**
+ * @brief Check at compile time that objects fit a memory budget
+ * 
+ * @code
+ * static_assert(frp::fits_memory_budget<4096, Graph, frp::Sink<int>>, "Controller exceeds 4 KiB");
+ * @endcode
+ * 
+ * @tparam Budget Budget in bytes, external storage included
+ */
+template<std::size_t Budget, typename... Ts>
+inline constexpr bool fits_memory_budget = memory_footprint_v<Ts...>.total() <= Budget;
+
+/**
+ * @brief Static memory of one graph element
+ */
+struct node_memory {
+    std::size_t element = 0;   ///< Index used with get_cell()
+    std::size_t offset = 0;    ///< Byte offset of the stored part within the graph
+    std::size_t flag_bits = 0; ///< Bits in the graph's flag bitset
+    memory_usage usage;        ///< Stored part; metadata is the padding that follows it
+};
+
+namespace detail {
+    /**
+     * @brief Fails to compile, naming the largest element, when a graph exceeds Budget
+     */
+    template<std::size_t Budget, std::size_t Used, std::size_t LargestElement, std::size_t LargestBytes>
+    struct memory_budget_check {
+        static_assert(Used <= Budget,
+                      "Graph exceeds its memory budget (see Used, and LargestElement/LargestBytes for the biggest node)");
+        static constexpr bool value = true;
+    };
+} // namespace detail
+
+/**
+ * @brief A reactive graph represents a network of cells and behaviors
+ * 
+ * Boolean cells and the occurrence flags of signals are packed into a bitset
+ * rather than stored as padded bytes; get_cell() returns a small proxy with
+ * the same interface for those elements. The bitset also allows word-wide
+ * queries over all flags (any_occurred(), any_true(), ...).
+ * 
+ * Elements are stored in the order chosen by a layout policy (by default by
+ * decreasing alignment, which removes padding); get_cell<I>() maps the index
+ * through a compile-time permutation, and checkpoint images always use
+ * declaration order.
+ * 
+ * @tparam Layout Layout policy (declaration_order, by_alignment, by_hotness)
+ * @tparam Cells Types of cells in the graph
+ */
+template<typename Layout, typename... Cells>
+class BasicReactiveGraph {
+private:
+    static constexpr std::size_t element_count = sizeof...(Cells);
+    
+    template<std::size_t I>
+    using element_t = std::tuple_element_t<I, std::tuple<Cells...>>;
+    
+    static_assert((detail::delay_fits<Cells, std::tuple<Cells...>>() && ...),
+                  "A delay must name a cell of the graph (not a signal or another delay) with the same value type");
+    
+    static constexpr std::array<bool, element_count> is_packed{detail::packing<Cells>::packed...};
+    static constexpr std::array<bool, element_count> is_signal{
+        (detail::packing<Cells>::packed && !std::is_same_v<Cells, Cell<bool>>)...};
+    static constexpr std::size_t flag_count = (std::size_t{0} + ... + (detail::packing<Cells>::packed ? 1 : 0));
+    
+    using word_type = detail::bit_word_t<flag_count>;
+    using flag_array = std::conditional_t<flag_count == 0, detail::no_flags,
+        std::array<word_type, (flag_count + sizeof(word_type) * 8 - 1) / (sizeof(word_type) * 8)>>;
+    using payload_tuple = decltype(std::tuple_cat(std::declval<detail::payload_tuple_t<Cells>>()...));
+    
+    static constexpr std::size_t word_bits = sizeof(word_type) * 8;
+    
+    // Bit of each packed element, payload slot of each element with a payload
+    static constexpr std::array<std::size_t, element_count> flag_index = [] {
+        std::array<std::size_t, element_count> result{};
+        std::size_t next = 0;
+        for (std::size_t i = 0; i < element_count; ++i) {
+            result[i] = is_packed[i] ? next++ : element_count;
+        }
+        return result;
+    }();
+    
+    static constexpr std::array<bool, element_count> has_payload{
+        !std::is_void_v<typename detail::packing<Cells>::payload>...};
+    static constexpr std::size_t payload_count = std::tuple_size_v<payload_tuple>;
+    
+    // Storage position k holds payload storage_order[k] (payloads counted in declaration order)
+    static constexpr std::array<std::size_t, payload_count> storage_order = [] {
+        constexpr std::array<std::size_t, payload_count> sizes = []<std::size_t... Ks>(std::index_sequence<Ks...>) {
+            return std::array<std::size_t, payload_count>{sizeof(std::tuple_element_t<Ks, payload_tuple>)...};
+        }(std::make_index_sequence<payload_count>{});
+        constexpr std::array<std::size_t, payload_count> alignments = []<std::size_t... Ks>(std::index_sequence<Ks...>) {
+            return std::array<std::size_t, payload_count>{alignof(std::tuple_element_t<Ks, payload_tuple>)...};
+        }(std::make_index_sequence<payload_count>{});
+        std::array<layout_entry, payload_count> entries{};
+        std::size_t next = 0;
+        for (std::size_t i = 0; i < element_count; ++i) {
+            if (has_payload[i]) {
+                entries[next] = layout_entry{i, sizes[next], alignments[next]};
+                ++next;
+            }
+        }
+        return Layout::order(entries);
+    }();
+    
+    static constexpr std::array<std::size_t, element_count> payload_index = [] {
+        std::array<std::size_t, payload_count> position{};
+        for (std::size_t k = 0; k < payload_count; ++k) {
+            position[storage_order[k]] = k;
+        }
+        std::array<std::size_t, element_count> result{};
+        std::size_t next = 0;
+        for (std::size_t i = 0; i < element_count; ++i) {
+            result[i] = has_payload[i] ? position[next++] : element_count;
+        }
+        return result;
+    }();
+    
+    using storage_type = decltype([]<std::size_t... Ks>(std::index_sequence<Ks...>) {
+        return std::type_identity<detail::ordered_storage<std::index_sequence<Ks...>,
+                                                          std::tuple_element_t<storage_order[Ks], payload_tuple>...>>{};
+    }(std::make_index_sequence<payload_count>{}))::type;
+    
+    using storage_sequence = decltype([]<std::size_t... Ks>(std::index_sequence<Ks...>) {
+        return std::index_sequence<storage_order[Ks]...>{};
+    }(std::make_index_sequence<payload_count>{}));
+    
+    static constexpr flag_array flag_mask(const std::array<bool, element_count>& kind) {
+        flag_array mask{};
+        if constexpr (flag_count > 0) {
+            for (std::size_t i = 0; i < element_count; ++i) {
+                if (kind[i]) {
+                    mask[flag_index[i] / word_bits] |= static_cast<word_type>(word_type{1} << (flag_index[i] % word_bits));
+                }
+            }
+        }
+        return mask;
+    }
+    
+    static constexpr flag_array bool_mask = flag_mask([] {
+        std::array<bool, element_count> kind{};
+        for (std::size_t i = 0; i < element_count; ++i) {
+            kind[i] = is_packed[i] && !is_signal[i];
+        }
+        return kind;
+    }());
+    static constexpr flag_array signal_mask = flag_mask(is_signal);
+    
+    [[no_unique_address]] flag_array flags_;
+    storage_type elements_;
+    
+    static constexpr flag_array initial_flags(const Cells&... cells) {
+        flag_array flags{};
+        std::size_t i = 0;
+        ([&] {
+            if constexpr (detail::packing<Cells>::packed) {
+                if (detail::packed_flag(cells)) {
+                    flags[flag_index[i] / word_bits] |= static_cast<word_type>(word_type{1} << (flag_index[i] % word_bits));
+                }
+            }
+            ++i;
+        }(), ...);
+        return flags;
+    }
+    
+    template<std::size_t I>
+    static constexpr word_type bit_of() noexcept {
+        return static_cast<word_type>(word_type{1} << (flag_index[I] % word_bits));
+    }
+    
+    template<std::size_t I>
+    constexpr auto& payload() noexcept {
+        return detail::storage_get<payload_index[I]>(elements_);
+    }
+    
+    template<std::size_t I>
+    constexpr const auto& payload() const noexcept {
+        return detail::storage_get<payload_index[I]>(elements_);
+    }
+    
+    // Calls f.template operator()<I>() for every element with a payload, in declaration order
+    template<typename F>
+    static constexpr void for_each_payload(F&& f) {
+        [&f]<std::size_t... Is>(std::index_sequence<Is...>) {
+            ([&f] {
+                if constexpr (has_payload[Is]) {
+                    f.template operator()<Is>();
+                }
+            }(), ...);
+        }(std::make_index_sequence<element_count>{});
+    }
+    
+    template<std::size_t I>
+    constexpr decltype(auto) cell_ref() {
+        using E = element_t<I>;
+        if constexpr (std::is_same_v<E, Cell<bool>>) {
+            return detail::packed_bool_cell<word_type, false>(&flags_[flag_index[I] / word_bits], bit_of<I>());
+        } else if constexpr (detail::packing<E>::packed) {
+            return detail::packed_signal<typename E::value_type, word_type, false>(
+                &payload<I>(), &flags_[flag_index[I] / word_bits], bit_of<I>());
+        } else {
+            return payload<I>();
+        }
+    }
+    
+    template<std::size_t I>
+    constexpr decltype(auto) cell_ref() const {
+        using E = element_t<I>;
+        if constexpr (std::is_same_v<E, Cell<bool>>) {
+            return detail::packed_bool_cell<word_type, true>(&flags_[flag_index[I] / word_bits], bit_of<I>());
+        } else if constexpr (detail::packing<E>::packed) {
+            return detail::packed_signal<typename E::value_type, word_type, true>(
+                &payload<I>(), &flags_[flag_index[I] / word_bits], bit_of<I>());
+        } else {
+            return payload<I>();
+        }
+    }
+    
+    // Memory of the part of an element stored in the element storage
+    template<typename E>
+    static constexpr memory_usage element_usage() noexcept {
+        if constexpr (std::is_void_v<typename detail::packing<E>::payload>) {
+            return {};
+        } else {
+            return memory_traits<typename detail::packing<E>::payload>::usage;
+        }
+    }
+    
+    template<typename E>
+    static constexpr std::size_t element_alignment() noexcept {
+        if constexpr (std::is_void_v<typename detail::packing<E>::payload>) {
+            return 1;
+        } else {
+            return alignof(typename detail::packing<E>::payload);
+        }
+    }
+    
+    // Reports an access to element I to a profiling layout policy
+    template<std::size_t I>
+    static constexpr void record_access() {
+        if constexpr (detail::profiling_layout<Layout>) {
+            Layout::record_access(I);
+        }
+    }
+    
+    template<std::size_t... Is>
+    constexpr auto cells_view(std::index_sequence<Is...>) const {
+        if constexpr (detail::profiling_layout<Layout>) {
+            return std::tuple<detail::recorded_cell<Layout, Is, decltype(cell_ref<Is>())>...>(cell_ref<Is>()...);
+        } else {
+            return std::tuple<decltype(cell_ref<Is>())...>(cell_ref<Is>()...);
+        }
+    }
+    
+    constexpr std::size_t count_flags(const flag_array& mask) const noexcept {
+        std::size_t count = 0;
+        if constexpr (flag_count > 0) {
+            for (std::size_t w = 0; w < flags_.size(); ++w) {
+                count += static_cast<std::size_t>(std::popcount(static_cast<word_type>(flags_[w] & mask[w])));
+            }
+        }
+        return count;
+    }
+    
+    constexpr bool any_flag(const flag_array& mask) const noexcept {
+        if constexpr (flag_count > 0) {
+            for (std::size_t w = 0; w < flags_.size(); ++w) {
+                if (flags_[w] & mask[w]) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+    
+public:
+    /**
+     * @brief Constructor with cells
+     */
+    constexpr explicit BasicReactiveGraph(Cells... cells) 
+        : flags_(initial_flags(cells...))
+        , elements_(std::tuple_cat(detail::pack_payload(std::move(cells))...),
+                    storage_sequence{}) {}
+    
+    /**
+     * @brief Get a cell from the graph
+     * 
+     * @tparam I Index of the cell
+     * @return Reference to the cell, or a proxy for packed boolean cells and signals
+     */
+    template<std::size_t I>
+    constexpr decltype(auto) get_cell() {
+        record_access<I>();
+        return cell_ref<I>();
+    }
+    
+    /**
+     * @brief Get a cell from the graph (const version)
+     * 
+     * @tparam I Index of the cell
+     * @return Const reference to the cell, or a proxy for packed boolean cells and signals
+     */
+    template<std::size_t I>
+    constexpr decltype(auto) get_cell() const {
+        record_access<I>();
+        return cell_ref<I>();
+    }
+    
+    /**
+     * @brief Tuple of (const) references to all cells, as passed to update functions
+     * 
+     * Element I supports `std::get<I>(cells).value()` like the cell itself.
+     */
+    constexpr auto cells() const {
+        return cells_view(std::make_index_sequence<element_count>{});
+    }
+    
+    /**
+     * @brief Update the graph based on dependencies
+     * 
+     * The cells tuple is built once for the whole batch; it refers to the
+     * graph's storage, so each function sees the values written before it.
+     * 
+     * @tparam Deps Dependency indices
+     * @param update_functions Functions to update cells
+     */
+    template<std::size_t... Deps, typename... Fs>
+    constexpr void update(detail::index_sequence<Deps...>, Fs&&... update_functions) {
+        static_assert((!is_constant<Deps>() && ...), "Constant cells cannot be updated; their value is fixed at compile time");
+        const auto view = cells();
+        (get_cell<Deps>().set_value(update_functions(view)), ...);
+    }
+    
+    /**
+     * @brief Update a specific cell
+     * 
+     * @tparam I Index of the cell to update
+     * @param f Function to compute the new value
+     */
+    template<std::size_t I, typename F>
+    constexpr void update_cell(F&& f) {
+        static_assert(!is_constant<I>(), "Constant cells cannot be updated; their value is fixed at compile time");
+        get_cell<I>().set_value(f(cells()));
+    }
+    
+    /**
+     * @brief Update a specific cell from the values of the cells it reads
+     * 
+     * Like update_cell(), but f receives the values of the listed cells
+     * instead of the cells tuple, so only those cells are looked up.
+     * Optimized builds drop the unused entries of the tuple anyway; without
+     * optimization, building it costs a step per graph element on every
+     * update, which this form avoids in large graphs.
+     * 
+     * @code
+     * graph.update_cell_from<POWER, THROTTLE, TEMPERATURE>([](float throttle, float temp) {
+     *     return derate(throttle, temp);
+     * });
+     * @endcode
+     * 
+     * @tparam I Index of the cell to update
+     * @tparam Reads Indices of the cells whose values are passed to f, in order
+     * @param f Function computing the new value from those values
+     */
+    template<std::size_t I, std::size_t... Reads, typename F>
+    constexpr void update_cell_from(F&& f) {
+        static_assert(!is_constant<I>(), "Constant cells cannot be updated; their value is fixed at compile time");
+        get_cell<I>().set_value(f(get_cell<Reads>().value()...));
+    }
+    
+    /**
+     * @brief Update a cell by modifying its value in place
+     * 
+     * For large values of which a tick changes only a part (sample buffers,
+     * waveforms): f receives a mutable reference to the value and the cells
+     * tuple, edits the value and returns whether it changed anything (a void
+     * result counts as a change). The value is neither rebuilt nor copied.
+     * The cells tuple also refers to cell I, so reads of it see the edits.
+     * 
+     * @tparam I Index of the cell to update
+     * @param f Function `(T& value, const auto& cells)`
+     * @return true if f reported a change
+     */
+    template<std::size_t I, typename F>
+    constexpr bool update_cell_in_place(F&& f) {
+        static_assert(!is_constant<I>(), "Constant cells cannot be updated; their value is fixed at compile time");
+        return get_cell<I>().modify([this, &f](auto& value) { return f(value, cells()); });
+    }
+    
+    /**
+     * @brief Copy the value of a cell from another graph of the same type
+     * 
+     * Copies the stored value, or the bit of a packed boolean cell, and
+     * leaves the rest of the graph alone. Signals are skipped since they
+     * occur for one tick only; constant cells have nothing to copy.
+     * 
+     * @tparam I Index of the cell
+     * @param other Graph to copy from
+     */
+    template<std::size_t I>
+    constexpr void copy_value(const BasicReactiveGraph& other) {
+        if constexpr (std::is_same_v<element_t<I>, Cell<bool>>) {
+            word_type& word = flags_[flag_index[I] / word_bits];
+            const word_type bit = bit_of<I>();
+            word = static_cast<word_type>((word & ~bit) | (other.flags_[flag_index[I] / word_bits] & bit));
+        } else if constexpr (has_payload[I] && !is_signal[I] && !is_const_cell_v<element_t<I>>) {
+            payload<I>() = other.payload<I>();
+        }
+    }
+    
+    /**
+     * @brief Latch the current value of every delayed cell into its delay
+     * 
+     * Call once at the end of each tick, after the last update; reads of a
+     * delay during the next tick then see this tick's value. TickExecutor
+     * calls it after every tick.
+     */
+    constexpr void advance_delays() {
+        for_each_payload([this]<std::size_t I>() {
+            if constexpr (is_delay_v<element_t<I>>) {
+                payload<I>().latch(cell_ref<element_t<I>::source>().value());
+            }
+        });
+    }
+    
+    /**
+     * @brief Number of unit delays in the graph
+     */
+    static constexpr std::size_t delay_count() noexcept {
+        return (std::size_t{0} + ... + (is_delay_v<Cells> ? 1 : 0));
+    }
+    
+    /**
+     * @brief Check whether a cell is a compile-time constant
+     * 
+     * @tparam I Index of the cell
+     */
+    template<std::size_t I>
+    static constexpr bool is_constant() noexcept {
+        return is_const_cell_v<element_t<I>>;
+    }
+    
+    /**
+     * @brief Number of elements (cells, signals, delays, ...) of the graph
+     */
+    static constexpr std::size_t cell_count() noexcept {
+        return element_count;
+    }
+    
+    /**
+     * @brief Number of cells that are updated at run time
+     */
+    static constexpr std::size_t runtime_cell_count() noexcept {
+        return (std::size_t{0} + ... + (is_const_cell_v<Cells> ? 0 : 1));
+    }
+    
+    /**
+     * @brief Number of flags (boolean cells and signal occurrences) packed into the bitset
+     */
+    static constexpr std::size_t packed_flag_count() noexcept {
+        return flag_count;
+    }
+    
+    /**
+     * @brief Static memory of every element, in declaration order
+     * 
+     * Offsets follow the layout policy. The flag bitset and the padding before
+     * the first and after the last stored element are not attributed to any
+     * element; memory_footprint() counts them as metadata.
+     */
+    static constexpr std::array<node_memory, element_count> memory_breakdown() noexcept {
+        constexpr std::array<memory_usage, element_count> usages{element_usage<Cells>()...};
+        constexpr std::array<std::size_t, element_count> alignments{element_alignment<Cells>()...};
+        
+        std::array<node_memory, element_count> result{};
+        std::array<std::size_t, element_count> element_at{};
+        for (std::size_t i = 0; i < element_count; ++i) {
+            result[i].element = i;
+            result[i].flag_bits = is_packed[i] ? 1 : 0;
+            result[i].usage = usages[i];
+            if (has_payload[i]) {
+                element_at[payload_index[i]] = i;
+            }
+        }
+        
+        // Replay the placement done by ordered_storage after the flag bitset
+        const std::size_t flag_bytes = std::is_empty_v<flag_array> ? 0 : sizeof(flag_array);
+        const std::size_t base = (flag_bytes + alignof(storage_type) - 1) / alignof(storage_type) * alignof(storage_type);
+        std::size_t cursor = base;
+        std::size_t previous = element_count;
+        for (std::size_t k = 0; k < payload_count; ++k) {
+            const std::size_t e = element_at[k];
+            const std::size_t size = usages[e].object();
+            if (size == 0) {
+                result[e].offset = base;
+                continue;
+            }
+            const std::size_t offset = (cursor + alignments[e] - 1) / alignments[e] * alignments[e];
+            if (previous != element_count) {
+                result[previous].usage.metadata += offset - cursor;
+            }
+            result[e].offset = offset;
+            cursor = offset + size;
+            previous = e;
+        }
+        return result;
+    }
+    
+    /**
+     * @brief Total static memory of the graph, external storage included
+     * 
+     * object() equals sizeof the graph.
+     */
+    static constexpr memory_usage memory_footprint() noexcept {
+        memory_usage usage{};
+        for (const node_memory& node : memory_breakdown()) {
+            usage += node.usage;
+        }
+        usage.metadata += sizeof(BasicReactiveGraph) - usage.object();
+        return usage;
+    }
+    
+    /**
+     * @brief Check the graph against a memory budget at compile time
+     * 
+     * Meant for `static_assert(Graph::check_memory_budget<4096>())`. When the
+     * budget is exceeded, compilation fails in detail::memory_budget_check,
+     * whose template arguments give the bytes used and the index and size of
+     * the largest element.
+     * 
+     * @tparam Budget Budget in bytes, external storage included
+     */
+    template<std::size_t Budget>
+    static constexpr bool check_memory_budget() noexcept {
+        constexpr std::array<node_memory, element_count> nodes = memory_breakdown();
+        constexpr std::size_t largest = [&nodes] {
+            std::size_t best = 0;
+            for (std::size_t i = 1; i < element_count; ++i) {
+                if (nodes[i].usage.total() > nodes[best].usage.total()) {
+                    best = i;
+                }
+            }
+            return best;
+        }();
+        constexpr std::size_t largest_bytes = element_count > 0 ? nodes[largest].usage.total() : 0;
+        return detail::memory_budget_check<Budget, memory_footprint().total(), largest, largest_bytes>::value;
+    }
+    
+    /**
+     * @brief Check whether any signal of the graph occurred
+     */
+    constexpr bool any_occurred() const noexcept {
+        return any_flag(signal_mask);
+    }
+    
+    /**
+     * @brief Number of signals of the graph that occurred
+     */
+    constexpr std::size_t occurred_count() const noexcept {
+        return count_flags(signal_mask);
+    }
+    
+    /**
+     * @brief Reset the occurrence flags of all signals of the graph
+     */
+    constexpr void reset_signals() noexcept {
+        if constexpr (flag_count > 0) {
+            for (std::size_t w = 0; w < flags_.size(); ++w) {
+                flags_[w] = static_cast<word_type>(flags_[w] & ~signal_mask[w]);
+            }
+        }
+    }
+    
+    /**
+     * @brief Check whether any boolean cell of the graph is true
+     */
+    constexpr bool any_true() const noexcept {
+        return any_flag(bool_mask);
+    }
+    
+    /**
+     * @brief Check whether all boolean cells of the graph are true
+     */
+    constexpr bool all_true() const noexcept {
+        if constexpr (flag_count > 0) {
+            for (std::size_t w = 0; w < flags_.size(); ++w) {
+                if ((flags_[w] & bool_mask[w]) != bool_mask[w]) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+    
+    /**
+     * @brief Number of boolean cells of the graph that are true
+     */
+    constexpr std::size_t true_count() const noexcept {
+        return count_flags(bool_mask);
+    }
+    
+    /**
+     * @brief Hash of the graph topology, computed at compile time
+     * 
+     * Covers the number, order, types and sizes of the graph elements, so a
+     * checkpoint image taken from a different graph is rejected on restore.
+     */
+    static constexpr std::uint64_t topology_hash() noexcept {
+        std::uint64_t hash = detail::fnv1a(std::uint64_t{sizeof...(Cells)}, 0xcbf29ce484222325ull);
+        ((hash = detail::fnv1a(std::uint64_t{sizeof(Cells)}, detail::fnv1a(detail::type_name<Cells>(), hash))), ...);
+        return hash;
+    }
+    
+    /**
+     * @brief Size in bytes of a checkpoint image of this graph
+     */
+    static constexpr std::size_t checkpoint_size() noexcept
+        requires (Checkpointable<Cells> && ...) {
+        return sizeof(CheckpointHeader) + sizeof(flag_array) * (flag_count > 0 ? 1 : 0) +
+               []<typename... Ps>(std::type_identity<std::tuple<Ps...>>) {
+                   return (detail::checkpoint_size_of<Ps>() + ... + 0);
+               }(std::type_identity<payload_tuple>{});
+    }
+    
+    /**
+     * @brief Write the state of every graph element into a flat image
+     * 
+     * @param out Destination buffer, at least checkpoint_size() bytes
+     * @return Number of bytes written, or 0 if the buffer is too small
+     */
+    std::size_t checkpoint(std::span<std::byte> out) const
+        requires (Checkpointable<Cells> && ...) {
+        constexpr std::size_t total = checkpoint_size();
+        if (out.size() < total) {
+            return 0;
+        }
+        
+        CheckpointHeader header{CheckpointHeader::expected_magic, CheckpointHeader::current_version,
+                                topology_hash(), total - sizeof(CheckpointHeader)};
+        std::memcpy(out.data(), &header, sizeof(header));
+        
+        std::byte* p = out.data() + sizeof(header);
+        if constexpr (flag_count > 0) {
+            std::memcpy(p, flags_.data(), sizeof(flag_array));
+            p += sizeof(flag_array);
+        }
+        for_each_payload([this, &p]<std::size_t I>() {
+            detail::checkpoint_save(payload<I>(), p);
+            p += detail::checkpoint_size_of<std::remove_cvref_t<decltype(payload<I>())>>();
+        });
+        return total;
+    }
+    
+    /**
+     * @brief Restore the state of every graph element from a flat image
+     * 
+     * The image is validated before any element is touched; on failure the
+     * graph is left unchanged.
+     * 
+     * @param in Image produced by checkpoint() of a graph with the same topology
+     * @return true if the image was accepted
+     */
+    bool restore(std::span<const std::byte> in)
+        requires (Checkpointable<Cells> && ...) {
+        constexpr std::size_t total = checkpoint_size();
+        if (in.size() < total) {
+            return false;
+        }
+        
+        CheckpointHeader header{};
+        std::memcpy(&header, in.data(), sizeof(header));
+        if (header.magic != CheckpointHeader::expected_magic ||
+            header.version != CheckpointHeader::current_version ||
+            header.topology_hash != topology_hash() ||
+            header.payload_size != total - sizeof(CheckpointHeader)) {
+            return false;
+        }
+        
+        const std::byte* p = in.data() + sizeof(header);
+        if constexpr (flag_count > 0) {
+            std::memcpy(flags_.data(), p, sizeof(flag_array));
+            p += sizeof(flag_array);
+        }
+        for_each_payload([this, &p]<std::size_t I>() {
+            detail::checkpoint_load(payload<I>(), p);
+            p += detail::checkpoint_size_of<std::remove_cvref_t<decltype(payload<I>())>>();
+        });
+        return true;
+    }
+};
+
+/**
+ * @brief Reactive graph with the default, padding-free element layout
+ * 
+ * @tparam Cells Types of cells in the graph
+ */
+template<typename... Cells>
+using ReactiveGraph = BasicReactiveGraph<by_alignment, Cells...>;
+
+template<typename Layout, typename... Cells>
+struct memory_traits<BasicReactiveGraph<Layout, Cells...>> {
+    static constexpr memory_usage usage = BasicReactiveGraph<Layout, Cells...>::memory_footprint();
+};
+
+/**
+ * @brief Fixed-size buffer type that holds a checkpoint image of a graph
+ * 
+ * @tparam Graph Reactive graph type
+ */
+template<typename Graph>
+using checkpoint_image = std::array<std::byte, Graph::checkpoint_size()>;
+
+/**
+ * @brief Create a reactive graph from cells
+ * 
+ * @tparam Cells Types of cells
+ * @param cells Cells to include in the graph
+ * @return A new reactive graph
+ */
+template<typename... Cells>
+constexpr auto make_graph(Cells... cells) {
+    return ReactiveGraph<Cells...>(std::move(cells)...);
+}
+
+/**
+ * @brief Propagate the initial state of a graph at compile time
+ * 
+ * Runs the propagation in the compiler and returns the settled graph, so it
+ * can initialize a `constinit` global: the state is emitted into .data and
+ * needs no constructor at startup. Every element and update function must be
+ * usable in constant expressions (see detail::static_function).
+ * 
+ * @code
+ * constinit auto graph = frp::settle(
+ *     frp::make_graph(frp::Cell<float>(20.0f), frp::Cell<bool>(false)),
+ *     [](auto& g) {
+ *         g.template update_cell<1>([](const auto& cells) { return std::get<0>(cells).value() > 50.0f; });
+ *     });
+ * @endcode
+ * 
+ * @param graph Graph with its initial cell values
+ * @param propagate Called once with the graph to run its update schedule
+ * @return The graph after propagation
+ */
+template<typename Graph, typename F>
+    requires std::invocable<F&, Graph&>
+consteval Graph settle(Graph graph, F propagate) {
+    propagate(graph);
+    return graph;
+}
+
+/**
+ * @brief Linear arena for payloads that live for one tick
+ * 
+ * Variable-size data (a decoded frame, a batch of messages) is placed in the
+ * arena and passed through signals as a std::span into it, so it is neither
+ * copied nor sized for the worst case in every node. Allocation bumps an
+ * offset; reset() releases everything at once in O(1). Objects are not
+ * destroyed, so only trivially destructible types can be placed.
+ * 
+ * @tparam Bytes Capacity in bytes
+ */
+template<std::size_t Bytes>
+class TickArena {
+private:
+    alignas(std::max_align_t) std::array<std::byte, Bytes> buffer_;
+    std::size_t used_ = 0;
+    std::size_t high_water_ = 0;
+    std::uint64_t failures_ = 0;
+    
+public:
+    /**
+     * @brief Place count default-initialized objects in the arena
+     * 
+     * @return The objects, or an empty span if the arena is exhausted
+     */
+    template<typename T>
+        requires std::is_trivially_destructible_v<T>
+    std::span<T> allocate(std::size_t count) noexcept {
+        static_assert(alignof(T) <= alignof(std::max_align_t), "Over-aligned types cannot be placed in a TickArena");
+        const std::size_t offset = (used_ + alignof(T) - 1) / alignof(T) * alignof(T);
+        if (count > (Bytes - (offset < Bytes ? offset : Bytes)) / sizeof(T)) {
+            ++failures_;
+            return {};
+        }
+        T* items = reinterpret_cast<T*>(buffer_.data() + offset);
+        for (std::size_t i = 0; i < count; ++i) {
+            ::new (static_cast<void*>(items + i)) T;
+        }
+        used_ = offset + count * sizeof(T);
+        if (used_ > high_water_) {
+            high_water_ = used_;
+        }
+        return std::span<T>(items, count);
+    }
+    
+    /**
+     * @brief Copy data into the arena
+     * 
+     * @return The copy, or an empty span if the arena is exhausted
+     */
+    template<typename T>
+        requires std::is_trivially_copyable_v<T>
+    std::span<const T> copy(std::span<const T> data) noexcept {
+        std::span<T> items = allocate<T>(data.size());
+        if (items.size() != data.size()) {
+            return {};
+        }
+        if (!data.empty()) {
+            std::memcpy(items.data(), data.data(), data.size_bytes());
+        }
+        return items;
+    }
+    
+    /**
+     * @brief Release everything placed in the arena
+     */
+    void reset() noexcept {
+        used_ = 0;
+    }
+    
+    /**
+     * @brief Bytes in use, alignment padding included
+     */
+    std::size_t used() const noexcept {
+        return used_;
+    }
+    
+    /**
+     * @brief Highest use since construction, for sizing the arena
+     */
+    std::size_t high_water() const noexcept {
+        return high_water_;
+    }
+    
+    /**
+     * @brief Number of allocations that did not fit
+     */
+    std::uint64_t failures() const noexcept {
+        return failures_;
+    }
+    
+    static constexpr std::size_t capacity() noexcept {
+        return Bytes;
+    }
+};
+
+/**
+ * @brief Runs the ticks of a graph and owns its per-tick arena
+ * 
+ * At the end of every tick the delays of the graph latch their cells, the
+ * signals are reset and the arena is released, so spans into the arena must
+ * only be carried by signals (or used within the tick), never stored in
+ * cells.
+ * 
+ * @code
+ * frp::TickExecutor<Graph, 4096> executor(std::move(graph));
+ * executor.tick([&](Graph& g, auto& arena) {
+ *     auto frame = arena.copy(std::span<const std::uint8_t>(rx, rx_len));
+ *     g.get_cell<FRAME>().fire(frame);
+ *     g.update_cell<CHECKSUM>(checksum_of_frame);
+ * });
+ * @endcode
+ * 
+ * @tparam Graph Reactive graph type
+ * @tparam ArenaBytes Capacity of the arena in bytes
+ */
+template<typename Graph, std::size_t ArenaBytes>
+class TickExecutor {
+private:
+    Graph graph_;
+    TickArena<ArenaBytes> arena_;
+    std::uint64_t ticks_ = 0;
+    
+public:
+    /**
+     * @brief Arena type handed to each tick
+     */
+    using arena_type = TickArena<ArenaBytes>;
+    
+    constexpr explicit TickExecutor(Graph graph) : graph_(std::move(graph)) {}
+    
+    /**
+     * @brief Run one tick
+     * 
+     * @param step Called with the graph and the arena; feeds inputs and runs
+     *        the update schedule
+     */
+    template<typename F>
+        requires std::invocable<F&, Graph&, arena_type&>
+    void tick(F&& step) {
+        step(graph_, arena_);
+        graph_.advance_delays();
+        graph_.reset_signals();
+        arena_.reset();
+        ++ticks_;
+    }
+    
+    constexpr Graph& graph() noexcept {
+        return graph_;
+    }
+    
+    constexpr const Graph& graph() const noexcept {
+        return graph_;
+    }
+    
+    const arena_type& arena() const noexcept {
+        return arena_;
+    }
+    
+    /**
+     * @brief Number of completed ticks
+     */
+    std::uint64_t ticks() const noexcept {
+        return ticks_;
+    }
+};
+
+/**
+ * @brief Double-buffered (Jacobi) evaluation of a graph
+ * 
+ * Holds two copies of a graph. Update functions read the previous tick's
+ * values and write the current tick's, so the nodes of a tick do not depend
+ * on each other: they can be updated in any order, split across threads,
+ * and loops over them vectorize because reads and writes never alias. The
+ * price is one tick of latency per edge: a change to an input reaches a node
+ * N edges away after N ticks.
+ * 
+ * @code
+ * frp::DoubleBufferedGraph<Graph> sim(graph);
+ * sim.current().get_cell<INPUT>().set_value(sample);
+ * sim.update_cell<B>([](const auto& prev) { return std::get<A>(prev).value() * 0.5f; });
+ * sim.update_cell<A>([](const auto& prev) { return std::get<INPUT>(prev).value(); });
+ * sim.end_tick();
+ * @endcode
+ * 
+ * end_tick() swaps the buffers without copying the graph. Cells written by
+ * the update functions are recorded; only the others (inputs set through
+ * current(), delays) are copied into the new current buffer, so a graph
+ * whose nodes are all rewritten every tick moves no data between ticks.
+ * Until a node is written, its value in current() is stale; a node skipped
+ * in a tick is brought up to date when the tick ends, and an in-place
+ * update first copies the previous value. A cell is therefore either an
+ * input, set through current(), or a node written through this class, not
+ * both. Signals are reset, as they occur for one tick only. Delays latch
+ * too; since every read already sees the previous tick, they read the same
+ * as the cells they delay.
+ * 
+ * Updates of different cells may run on different threads, except that
+ * boolean cells and signals of the graph share words of its flag bitset:
+ * update those from one thread.
+ * 
+ * @tparam Graph Reactive graph type
+ */
+template<typename Graph>
+class DoubleBufferedGraph {
+private:
+    static constexpr std::size_t cell_count = Graph::cell_count();
+    
+    std::array<Graph, 2> buffers_;
+    std::size_t current_ = 0;
+    std::uint64_t ticks_ = 0;
+    // Cells written in this tick, and cells whose current value predates the
+    // previous tick; one byte each so that threads updating different cells
+    // do not share a word
+    std::array<bool, cell_count> written_{};
+    std::array<bool, cell_count> stale_{};
+    
+    // Calls f.template operator()<I>() for every cell index
+    template<typename F>
+    static constexpr void for_each_cell(F&& f) {
+        [&f]<std::size_t... Is>(std::index_sequence<Is...>) {
+            (f.template operator()<Is>(), ...);
+        }(std::make_index_sequence<cell_count>{});
+    }
+    
+public:
+    constexpr explicit DoubleBufferedGraph(const Graph& graph) : buffers_{graph, graph} {}
+    
+    /**
+     * @brief Values of the previous tick, read by update functions
+     */
+    constexpr const Graph& previous() const noexcept {
+        return buffers_[current_ ^ 1];
+    }
+    
+    /**
+     * @brief Values being written in this tick; inputs are set here
+     */
+    constexpr Graph& current() noexcept {
+        return buffers_[current_];
+    }
+    
+    constexpr const Graph& current() const noexcept {
+        return buffers_[current_];
+    }
+    
+    /**
+     * @brief Update a cell from the previous tick's values
+     * 
+     * @tparam I Index of the cell to update
+     * @param f Function computing the new value from previous().cells()
+     */
+    template<std::size_t I, typename F>
+    constexpr void update_cell(F&& f) {
+        static_assert(!Graph::template is_constant<I>(), "Constant cells cannot be updated; their value is fixed at compile time");
+        current().template get_cell<I>().set_value(f(previous().cells()));
+        written_[I] = true;
+    }
+    
+    /**
+     * @brief Update a cell in place from the previous tick's values
+     * 
+     * The value starts as the previous tick's, so editing it in place is
+     * equivalent to rebuilding it.
+     * 
+     * @param f Function `(T& value, const auto& previous_cells)`
+     * @return true if f reported a change
+     */
+    template<std::size_t I, typename F>
+    constexpr bool update_cell_in_place(F&& f) {
+        static_assert(!Graph::template is_constant<I>(), "Constant cells cannot be updated; their value is fixed at compile time");
+        if (stale_[I]) {
+            current().template copy_value<I>(previous());
+            stale_[I] = false;
+        }
+        written_[I] = true;
+        return current().template get_cell<I>().modify([this, &f](auto& value) { return f(value, previous().cells()); });
+    }
+    
+    /**
+     * @brief Update several cells; their order does not matter
+     */
+    template<std::size_t... Is, typename... Fs>
+    constexpr void update(detail::index_sequence<Is...>, Fs&&... update_functions) {
+        (update_cell<Is>(std::forward<Fs>(update_functions)), ...);
+    }
+    
+    /**
+     * @brief Close the tick: the current values become the previous ones
+     * 
+     * Copies only the cells not written in the tick; see the class notes.
+     */
+    constexpr void end_tick() {
+        current().advance_delays();
+        for_each_cell([this]<std::size_t I>() {
+            if (stale_[I] && !written_[I]) {
+                current().template copy_value<I>(previous());
+            }
+        });
+        current_ ^= 1;
+        for_each_cell([this]<std::size_t I>() {
+            if (!written_[I]) {
+                current().template copy_value<I>(previous());
+            }
+        });
+        current().reset_signals();
+        stale_ = written_;
+        written_ = {};
+        ++ticks_;
+    }
+    
+    /**
+     * @brief Number of completed ticks
+     */
+    constexpr std::uint64_t ticks() const noexcept {
+        return ticks_;
+    }
+};
+
+/**
+ * @brief Both buffers count; external storage (tables, caches) is shared
+ */
+template<typename Graph>
+struct memory_traits<DoubleBufferedGraph<Graph>> {
+    static constexpr memory_usage usage{
+        2 * memory_traits<Graph>::usage.values, 2 * memory_traits<Graph>::usage.functions,
+        sizeof(DoubleBufferedGraph<Graph>) - 2 * (memory_traits<Graph>::usage.values + memory_traits<Graph>::usage.functions),
+        memory_traits<Graph>::usage.external};
+};
+
+/**
+ * @brief A signal represents a discrete event with a value
+ * 
+ * @tparam T Type of the value carried by the signal
+ */
+template<CellValue T>
+class Signal {
+private:
+    T value_;
+    bool occurred_;
+    
+public:
+    /**
+     * @brief Type of the value carried by the signal
+     */
+    using value_type = T;
+    
+    /**
+     * @brief Default constructor
+     */
+    constexpr Signal() : value_{}, occurred_(false) {}
+    
+    /**
+     * @brief Constructor with value
+     */
+    constexpr explicit Signal(T value) : value_(std::move(value)), occurred_(true) {}
+    
+    /**
+     * @brief Check if the signal occurred
+     */
+    constexpr bool occurred() const noexcept {
+        return occurred_;
+    }
+    
+    /**
+     * @brief Get the value of the signal
+     */
+    constexpr const T& value() const noexcept {
+        return value_;
+    }
+    
+    /**
+     * @brief Reset the signal
+     */
+    constexpr void reset() noexcept {
+        occurred_ = false;
+    }
+    
+    /**
+     * @brief Fire the signal with a value
+     */
+    constexpr void fire(T new_value) {
+        value_ = std::move(new_value);
+        occurred_ = true;
+    }
+    
+    /**
+     * @brief Map function to transform the signal
+     * 
+     * The value is passed by const reference; the result is stored in the
+     * new signal. To select part of a large value without copying it, map
+     * a view() instead.
+     * 
+     * @tparam F Function type
+     * @param f Function to apply to the signal value
+     * @return A new signal with the transformed value
+     */
+    template<typename F>
+    constexpr auto map(F&& f) const {
+        using R = std::remove_cvref_t<std::invoke_result_t<F&, const T&>>;
+        if (occurred_) {
+            return Signal<R>(f(value_));
+        } else {
             return Signal<R>();
         }
     }
+    
+    /**
+     * @brief View of the signal, without copying the value
+     */
+    constexpr SignalView<T> view() const& noexcept {
+        return SignalView<T>(occurred_ ? &value_ : nullptr);
+    }
+    
+    /**
+     * @brief A view of a temporary signal (e.g. `s.map(f).view()`) would dangle
+     */
+    void view() const&& = delete;
+};
+
+/**
+ * @brief Non-owning view of a signal: its occurrence and a reference to its value
+ * 
+ * Filtering or projecting a view copies a pointer instead of the payload,
+ * which matters for frame-sized values (camera lines, CAN batches). A view
+ * is valid as long as the viewed signal is neither fired again nor
+ * destroyed, i.e. within the tick; it must not be stored across ticks.
+ * 
+ * @tparam T Type of the viewed value
+ */
+template<typename T>
+class SignalView {
+private:
+    const T* value_ = nullptr;
+    
+public:
+    /**
+     * @brief Type of the viewed value
+     */
+    using value_type = T;
+    
+    /**
+     * @brief View of a signal that did not occur
+     */
+    constexpr SignalView() noexcept = default;
+    
+    /**
+     * @brief View of a value; null if the signal did not occur
+     */
+    constexpr explicit SignalView(const T* value) noexcept : value_(value) {}
+    
+    constexpr bool occurred() const noexcept {
+        return value_ != nullptr;
+    }
+    
+    constexpr const T& value() const noexcept {
+        return *value_;
+    }
+    
+    /**
+     * @brief Map function over the viewed value
+     * 
+     * @param f Called with `const T&`. If it returns a reference (a member,
+     *        an element), the result is again a view; otherwise the result
+     *        is stored in a new Signal.
+     */
+    template<typename F>
+    constexpr auto map(F&& f) const {
+        using R = std::invoke_result_t<F&, const T&>;
+        if constexpr (std::is_lvalue_reference_v<R>) {
+            using U = std::remove_cvref_t<R>;
+            return occurred() ? SignalView<U>(&f(*value_)) : SignalView<U>();
+        } else {
+            using U = std::remove_cvref_t<R>;
+            return occurred() ? Signal<U>(f(*value_)) : Signal<U>();
+        }
+    }
 };
 
 /**
@@ -506,6 +3023,22 @@ constexpr auto filter(const Signal<T>& signal, F&& predicate) {
     }
 }
 
+/**
+ * @brief Filter a signal view based on a predicate, without copying the value
+ * 
+ * @param signal Input view
+ * @param predicate Function to test the viewed value (gets `const T&`)
+ * @return The input view if the predicate holds, otherwise an empty view
+ */
+template<typename T, typename F>
+constexpr SignalView<T> filter(SignalView<T> signal, F&& predicate) {
+    if (signal.occurred() && predicate(signal.value())) {
+        return signal;
+    } else {
+        return SignalView<T>();
+    }
+}
+
 /**
  * @brief A sink represents a consumer of signals
  * 
@@ -521,6 +3054,7 @@ public:
      * @brief Constructor with function
      */
     template<typename F>
+        requires std::is_invocable_v<const std::remove_cvref_t<F>&, const T&>
     constexpr explicit Sink(F&& f) : function_(std::forward<F>(f)) {}
     
     /**
@@ -531,6 +3065,29 @@ public:
             function_(signal.value());
         }
     }
+    
+    /**
+     * @brief Process a signal view
+     */
+    constexpr void process(SignalView<T> signal) {
+        if (signal.occurred()) {
+            function_(signal.value());
+        }
+    }
+    
+    /**
+     * @brief Process a signal stored in a graph, without copying the value
+     */
+    template<typename Word, bool Const>
+    constexpr void process(const detail::packed_signal<T, Word, Const>& signal) {
+        process(signal.view());
+    }
+};
+
+template<CellValue T>
+struct memory_traits<Sink<T>> {
+    static constexpr memory_usage usage{0, detail::static_function<void(const T&)>::buffer_size,
+                                        sizeof(Sink<T>) - detail::static_function<void(const T&)>::buffer_size, 0};
 };
 
 } // namespace frp
@@ -0,0 +1,319 @@
+/**
+ * @file frp_heap_guard.hpp
+ * @brief Debug checks that hot paths do not allocate
+ *
+ * Two tools for verifying the library's zero-heap claim on real code:
+ * - heap_guard marks a scope (a tick, an event handler) in which the current
+ *   thread must not use the heap; any allocation inside it prints a message
+ *   and aborts, so a payload that silently allocates (std::string,
+ *   std::vector, a capturing std::function) is caught by the first run
+ * - allocation_audit counts the allocations of the current thread over a
+ *   marked region, for tests and benchmarks that assert the count is zero
+ *
+ * Both rely on replacing the global operator new and delete. Define
+ * FRP_HEAP_GUARD_IMPLEMENTATION before including this header in exactly one
+ * translation unit of a debug, test or benchmark build; without it, neither
+ * tool sees any allocation. Defining FRP_HEAP_AUDIT_MALLOC as well also
+ * interposes malloc, calloc, realloc and the aligned variants (glibc only),
+ * which catches C code and libraries calling malloc directly.
+ *
+ * For a compile-time check of cell and signal payloads, see FRP_NO_HEAP in
+ * frp.hpp.
+ */
+
+#ifndef FRP_HEAP_GUARD_HPP
+#define FRP_HEAP_GUARD_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+namespace frp {
+
+namespace detail {
+    /**
+     * @brief Number of heap_guard scopes active on the calling thread
+     */
+    inline int& heap_guard_depth() noexcept {
+        thread_local int depth = 0;
+        return depth;
+    }
+
+    /**
+     * @brief Allocations made by the calling thread since it started
+     */
+    struct heap_counters {
+        std::uint64_t allocations = 0;
+        std::uint64_t bytes = 0;
+    };
+
+    inline heap_counters& thread_heap_counters() noexcept {
+        thread_local heap_counters counters;
+        return counters;
+    }
+
+    /**
+     * @brief Set once the replacement allocation functions are linked in
+     */
+    inline bool& heap_hooks_installed() noexcept {
+        static bool installed = false;
+        return installed;
+    }
+} // namespace detail
+
+/**
+ * @brief Scope in which the calling thread must not allocate
+ *
+ * Scopes nest. The global operator new is checked, and malloc and friends
+ * too when FRP_HEAP_AUDIT_MALLOC is defined.
+ */
+class heap_guard {
+public:
+    heap_guard() noexcept {
+        ++detail::heap_guard_depth();
+    }
+
+    ~heap_guard() {
+        --detail::heap_guard_depth();
+    }
+
+    heap_guard(const heap_guard&) = delete;
+    heap_guard& operator=(const heap_guard&) = delete;
+
+    /**
+     * @brief Check whether the calling thread is inside a heap_guard scope
+     */
+    static bool active() noexcept {
+        return detail::heap_guard_depth() > 0;
+    }
+};
+
+/**
+ * @brief Counts the allocations of the calling thread from construction on
+ *
+ * @code
+ * frp::allocation_audit audit;
+ * graph.update_cell<3>(compute_power);
+ * sink.process(alert);
+ * assert(audit.allocations() == 0);
+ * @endcode
+ *
+ * Allocations made by other threads are not counted.
+ */
+class allocation_audit {
+private:
+    detail::heap_counters start_;
+
+public:
+    allocation_audit() noexcept : start_(detail::thread_heap_counters()) {}
+
+    /**
+     * @brief Number of allocations since construction or restart()
+     */
+    std::uint64_t allocations() const noexcept {
+        return detail::thread_heap_counters().allocations - start_.allocations;
+    }
+
+    /**
+     * @brief Bytes requested since construction or restart()
+     */
+    std::uint64_t bytes() const noexcept {
+        return detail::thread_heap_counters().bytes - start_.bytes;
+    }
+
+    /**
+     * @brief Start counting again from zero
+     */
+    void restart() noexcept {
+        start_ = detail::thread_heap_counters();
+    }
+
+    /**
+     * @brief Check whether allocations are intercepted at all
+     *
+     * False if no translation unit defines FRP_HEAP_GUARD_IMPLEMENTATION, in
+     * which case allocations() is always zero.
+     */
+    static bool enabled() noexcept {
+        return detail::heap_hooks_installed();
+    }
+};
+
+} // namespace frp
+
+#ifdef FRP_HEAP_GUARD_IMPLEMENTATION
+
+#if defined(FRP_HEAP_AUDIT_MALLOC) && defined(__GLIBC__)
+#define FRP_HEAP_INTERPOSE_MALLOC 1
+
+// The allocator behind malloc, used by the interposed functions below
+extern "C" {
+    void* __libc_malloc(std::size_t size);
+    void* __libc_calloc(std::size_t count, std::size_t size);
+    void* __libc_realloc(void* ptr, std::size_t size);
+    void* __libc_memalign(std::size_t alignment, std::size_t size);
+    void __libc_free(void* ptr);
+}
+#endif
+
+namespace frp::detail {
+    /**
+     * @brief Count an allocation of the calling thread; abort inside a heap_guard
+     */
+    inline void note_allocation(std::size_t size) noexcept {
+        if (heap_guard::active()) {
+            // Printing may allocate itself
+            heap_guard_depth() = 0;
+            std::fputs("frp: heap allocation inside a heap_guard scope\n", stderr);
+            std::abort();
+        }
+        heap_counters& counters = thread_heap_counters();
+        ++counters.allocations;
+        counters.bytes += size;
+    }
+
+    inline const bool heap_hooks_registered = (heap_hooks_installed() = true);
+
+    inline void* guarded_allocate(std::size_t size, std::size_t alignment) noexcept {
+        note_allocation(size);
+        if (size == 0) {
+            size = 1;
+        }
+#if defined(FRP_HEAP_INTERPOSE_MALLOC)
+        return alignment <= alignof(std::max_align_t) ? __libc_malloc(size) : __libc_memalign(alignment, size);
+#else
+        if (alignment <= alignof(std::max_align_t)) {
+            return std::malloc(size);
+        }
+#if defined(_MSC_VER)
+        return _aligned_malloc(size, alignment);
+#else
+        return std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+#endif
+#endif
+    }
+
+    inline void guarded_free(void* ptr, std::size_t alignment) noexcept {
+#if defined(FRP_HEAP_INTERPOSE_MALLOC)
+        (void)alignment;
+        __libc_free(ptr);
+#else
+#if defined(_MSC_VER)
+        if (alignment > alignof(std::max_align_t)) {
+            _aligned_free(ptr);
+            return;
+        }
+#else
+        (void)alignment;
+#endif
+        std::free(ptr);
+#endif
+    }
+} // namespace frp::detail
+
+#if defined(FRP_HEAP_INTERPOSE_MALLOC)
+extern "C" {
+    void* malloc(std::size_t size) noexcept {
+        frp::detail::note_allocation(size);
+        return __libc_malloc(size);
+    }
+
+    void* calloc(std::size_t count, std::size_t size) noexcept {
+        frp::detail::note_allocation(count * size);
+        return __libc_calloc(count, size);
+    }
+
+    void* realloc(void* ptr, std::size_t size) noexcept {
+        frp::detail::note_allocation(size);
+        return __libc_realloc(ptr, size);
+    }
+
+    void* aligned_alloc(std::size_t alignment, std::size_t size) noexcept {
+        frp::detail::note_allocation(size);
+        return __libc_memalign(alignment, size);
+    }
+
+    void* memalign(std::size_t alignment, std::size_t size) noexcept {
+        frp::detail::note_allocation(size);
+        return __libc_memalign(alignment, size);
+    }
+
+    int posix_memalign(void** ptr, std::size_t alignment, std::size_t size) noexcept {
+        frp::detail::note_allocation(size);
+        *ptr = __libc_memalign(alignment, size);
+        return *ptr ? 0 : 12; // ENOMEM
+    }
+
+    void free(void* ptr) noexcept {
+        __libc_free(ptr);
+    }
+}
+#endif
+
+void* operator new(std::size_t size) {
+    if (void* ptr = frp::detail::guarded_allocate(size, alignof(std::max_align_t))) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return ::operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return frp::detail::guarded_allocate(size, alignof(std::max_align_t));
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return frp::detail::guarded_allocate(size, alignof(std::max_align_t));
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    if (void* ptr = frp::detail::guarded_allocate(size, static_cast<std::size_t>(alignment))) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    return ::operator new(size, alignment);
+}
+
+void operator delete(void* ptr) noexcept {
+    frp::detail::guarded_free(ptr, alignof(std::max_align_t));
+}
+
+void operator delete[](void* ptr) noexcept {
+    frp::detail::guarded_free(ptr, alignof(std::max_align_t));
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    frp::detail::guarded_free(ptr, alignof(std::max_align_t));
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept {
+    frp::detail::guarded_free(ptr, alignof(std::max_align_t));
+}
+
+void operator delete(void* ptr, std::align_val_t alignment) noexcept {
+    frp::detail::guarded_free(ptr, static_cast<std::size_t>(alignment));
+}
+
+void operator delete[](void* ptr, std::align_val_t alignment) noexcept {
+    frp::detail::guarded_free(ptr, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* ptr, std::size_t, std::align_val_t alignment) noexcept {
+    frp::detail::guarded_free(ptr, static_cast<std::size_t>(alignment));
+}
+
+void operator delete[](void* ptr, std::size_t, std::align_val_t alignment) noexcept {
+    frp::detail::guarded_free(ptr, static_cast<std::size_t>(alignment));
+}
+
+#endif // FRP_HEAP_GUARD_IMPLEMENTATION
+
+#endif // FRP_HEAP_GUARD_HPP
@@ -0,0 +1,634 @@
+/**
+ * @file frp_history.hpp
+ * @brief Columnar on-disk history of cell values (POSIX)
+ *
+ * This header provides an optional historian that stores the values of
+ * selected cells once per tick:
+ * - One memory-mapped column file per cell plus one for the timestamps
+ * - Values are XOR-compressed against the previous value (Gorilla encoding),
+ *   so a value that did not change costs a single bit
+ * - Timestamps are stored as delta-of-deltas, so a regular tick costs one bit
+ * - Columns are split into segments of a fixed number of ticks
+ * - A small query API scans one column over a time range
+ */
+
+#ifndef FRP_HISTORY_HPP
+#define FRP_HISTORY_HPP
+
+#include "frp.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <tuple>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace frp {
+
+/**
+ * @brief Header at the start of every history column file
+ */
+struct HistoryColumnHeader {
+    std::array<char, 8> magic;
+    std::uint32_t version;
+    std::uint32_t value_bits;  ///< Width of the stored values; 0 for the timestamp column
+    std::uint64_t segment_index;
+    std::uint64_t capacity;    ///< Size of the bit stream area in bytes
+    std::uint64_t count;       ///< Number of complete entries
+    std::uint64_t bits_used;   ///< Bits of the stream holding complete entries
+    std::uint64_t first_ns;    ///< First timestamp of the segment
+    std::uint64_t last_ns;     ///< Last timestamp of the segment
+
+    static constexpr std::array<char, 8> expected_magic{'F', 'R', 'P', 'H', 'I', 'S', 'T', 0};
+    static constexpr std::uint32_t current_version = 1;
+};
+
+static_assert(sizeof(HistoryColumnHeader) == 64, "History column header must stay 64 bytes");
+
+/**
+ * @brief Concept for cell values that can be stored by the historian
+ */
+template<typename T>
+concept HistoryValue = std::is_trivially_copyable_v<T> && sizeof(T) <= sizeof(std::uint64_t);
+
+namespace detail {
+    /**
+     * @brief Appends bits MSB-first to a zero-initialized byte area
+     */
+    class bit_writer {
+    private:
+        std::byte* data_ = nullptr;
+        std::uint64_t pos_ = 0;
+
+    public:
+        constexpr bit_writer() noexcept = default;
+        constexpr bit_writer(std::byte* data, std::uint64_t pos) noexcept : data_(data), pos_(pos) {}
+
+        constexpr std::uint64_t position() const noexcept {
+            return pos_;
+        }
+
+        void write(std::uint64_t value, unsigned bits) noexcept {
+            while (bits > 0) {
+                const unsigned offset = static_cast<unsigned>(pos_ & 7u);
+                const unsigned room = 8u - offset;
+                const unsigned take = bits < room ? bits : room;
+                const unsigned chunk = static_cast<unsigned>((value >> (bits - take)) & ((1u << take) - 1u));
+                data_[pos_ >> 3] |= static_cast<std::byte>(chunk << (room - take));
+                pos_ += take;
+                bits -= take;
+            }
+        }
+    };
+
+    /**
+     * @brief Reads bits MSB-first, the inverse of bit_writer
+     */
+    class bit_reader {
+    private:
+        const std::byte* data_ = nullptr;
+        std::uint64_t pos_ = 0;
+
+    public:
+        constexpr bit_reader(const std::byte* data) noexcept : data_(data) {}
+
+        std::uint64_t read(unsigned bits) noexcept {
+            std::uint64_t value = 0;
+            while (bits > 0) {
+                const unsigned offset = static_cast<unsigned>(pos_ & 7u);
+                const unsigned room = 8u - offset;
+                const unsigned take = bits < room ? bits : room;
+                const unsigned byte = static_cast<unsigned>(data_[pos_ >> 3]);
+                value = (value << take) | ((byte >> (room - take)) & ((1u << take) - 1u));
+                pos_ += take;
+                bits -= take;
+            }
+            return value;
+        }
+    };
+
+    /**
+     * @brief Gorilla XOR encoder state for one value column
+     *
+     * @tparam Bits Width of the encoded values (at most 64)
+     */
+    template<unsigned Bits>
+    struct xor_codec {
+        std::uint64_t previous = 0;
+        unsigned leading = 0;
+        unsigned trailing = 0;
+        bool first = true;
+        bool has_window = false;
+
+        void encode(bit_writer& out, std::uint64_t value) noexcept {
+            if (first) {
+                out.write(value, Bits);
+                previous = value;
+                first = false;
+                return;
+            }
+            const std::uint64_t x = value ^ previous;
+            previous = value;
+            if (x == 0) {
+                out.write(0, 1);
+                return;
+            }
+            unsigned lead = static_cast<unsigned>(std::countl_zero(x)) - (64u - Bits);
+            const unsigned trail = static_cast<unsigned>(std::countr_zero(x));
+            if (lead > 31u) {
+                lead = 31u;
+            }
+            if (has_window && lead >= leading && trail >= trailing) {
+                out.write(0b10, 2);
+                out.write(x >> trailing, Bits - leading - trailing);
+                return;
+            }
+            const unsigned significant = Bits - lead - trail;
+            out.write(0b11, 2);
+            out.write(lead, 5);
+            out.write(significant == 64u ? 0u : significant, 6);
+            out.write(x >> trail, significant);
+            leading = lead;
+            trailing = trail;
+            has_window = true;
+        }
+
+        std::uint64_t decode(bit_reader& in) noexcept {
+            if (first) {
+                previous = in.read(Bits);
+                first = false;
+                return previous;
+            }
+            if (in.read(1) == 0) {
+                return previous;
+            }
+            if (in.read(1) == 1) {
+                leading = static_cast<unsigned>(in.read(5));
+                unsigned significant = static_cast<unsigned>(in.read(6));
+                if (significant == 0) {
+                    significant = 64u;
+                }
+                trailing = Bits - leading - significant;
+            }
+            const unsigned significant = Bits - leading - trailing;
+            previous ^= in.read(significant) << trailing;
+            return previous;
+        }
+
+        // Worst case: control bits, window fields and all value bits
+        static constexpr std::size_t max_bits = 2 + 5 + 6 + Bits;
+    };
+
+    /**
+     * @brief Delta-of-delta encoder state for the timestamp column
+     */
+    struct timestamp_codec {
+        std::uint64_t previous = 0;
+        std::int64_t delta = 0;
+        bool first = true;
+
+        void encode(bit_writer& out, std::uint64_t t) noexcept {
+            if (first) {
+                out.write(t, 64);
+                previous = t;
+                first = false;
+                return;
+            }
+            const std::int64_t d = static_cast<std::int64_t>(t - previous);
+            const std::int64_t dod = d - delta;
+            previous = t;
+            delta = d;
+            if (dod == 0) {
+                out.write(0, 1);
+            } else if (dod >= -63 && dod <= 64) {
+                out.write(0b10, 2);
+                out.write(static_cast<std::uint64_t>(dod + 63), 7);
+            } else if (dod >= -255 && dod <= 256) {
+                out.write(0b110, 3);
+                out.write(static_cast<std::uint64_t>(dod + 255), 9);
+            } else if (dod >= -2047 && dod <= 2048) {
+                out.write(0b1110, 4);
+                out.write(static_cast<std::uint64_t>(dod + 2047), 12);
+            } else {
+                out.write(0b1111, 4);
+                out.write(static_cast<std::uint64_t>(dod), 64);
+            }
+        }
+
+        std::uint64_t decode(bit_reader& in) noexcept {
+            if (first) {
+                previous = in.read(64);
+                first = false;
+                return previous;
+            }
+            std::int64_t dod = 0;
+            if (in.read(1) == 1) {
+                if (in.read(1) == 0) {
+                    dod = static_cast<std::int64_t>(in.read(7)) - 63;
+                } else if (in.read(1) == 0) {
+                    dod = static_cast<std::int64_t>(in.read(9)) - 255;
+                } else if (in.read(1) == 0) {
+                    dod = static_cast<std::int64_t>(in.read(12)) - 2047;
+                } else {
+                    dod = static_cast<std::int64_t>(in.read(64));
+                }
+            }
+            delta += dod;
+            previous += static_cast<std::uint64_t>(delta);
+            return previous;
+        }
+
+        static constexpr std::size_t max_bits = 4 + 64;
+    };
+
+    /**
+     * @brief Bit pattern of a value, zero-extended to 64 bits
+     */
+    template<HistoryValue T>
+    std::uint64_t history_bits(const T& value) noexcept {
+        std::uint64_t bits = 0;
+        std::memcpy(&bits, &value, sizeof(T));
+        return bits;
+    }
+
+    template<HistoryValue T>
+    T history_value(std::uint64_t bits) noexcept {
+        T value;
+        std::memcpy(&value, &bits, sizeof(T));
+        return value;
+    }
+
+    /**
+     * @brief Build the file name of a history column into a fixed buffer
+     *
+     * The timestamp column uses the name "ts", value columns the cell index.
+     */
+    inline bool history_column_path(std::array<char, 256>& out, const char* prefix,
+                                     std::uint64_t segment, const char* column) {
+        int n = std::snprintf(out.data(), out.size(), "%s.%06llu.%s.frph",
+                              prefix, static_cast<unsigned long long>(segment), column);
+        return n > 0 && static_cast<std::size_t>(n) < out.size();
+    }
+
+    /**
+     * @brief A memory-mapped history column file
+     */
+    struct history_file {
+        int fd = -1;
+        std::byte* base = nullptr;
+        std::size_t mapped_bytes = 0;
+
+        HistoryColumnHeader& header() const noexcept {
+            return *reinterpret_cast<HistoryColumnHeader*>(base);
+        }
+
+        std::byte* stream() const noexcept {
+            return base + sizeof(HistoryColumnHeader);
+        }
+
+        bool create(const std::array<char, 256>& path, std::uint64_t segment,
+                    std::uint32_t value_bits, std::size_t capacity) {
+            fd = ::open(path.data(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+            if (fd < 0) {
+                return false;
+            }
+            mapped_bytes = sizeof(HistoryColumnHeader) + capacity;
+            // Sparse: disk blocks are only allocated for the compressed data written
+            if (::ftruncate(fd, static_cast<off_t>(mapped_bytes)) != 0) {
+                close(false);
+                return false;
+            }
+            void* addr = ::mmap(nullptr, mapped_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            if (addr == MAP_FAILED) {
+                close(false);
+                return false;
+            }
+            base = static_cast<std::byte*>(addr);
+
+            HistoryColumnHeader& h = header();
+            h.magic = HistoryColumnHeader::expected_magic;
+            h.version = HistoryColumnHeader::current_version;
+            h.value_bits = value_bits;
+            h.segment_index = segment;
+            h.capacity = capacity;
+            h.count = 0;
+            h.bits_used = 0;
+            h.first_ns = 0;
+            h.last_ns = 0;
+            return true;
+        }
+
+        bool map_read_only(const std::array<char, 256>& path) {
+            int rfd = ::open(path.data(), O_RDONLY | O_CLOEXEC);
+            if (rfd < 0) {
+                return false;
+            }
+            struct stat st{};
+            if (::fstat(rfd, &st) != 0 || static_cast<std::size_t>(st.st_size) < sizeof(HistoryColumnHeader)) {
+                ::close(rfd);
+                return false;
+            }
+            void* addr = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_SHARED, rfd, 0);
+            ::close(rfd);
+            if (addr == MAP_FAILED) {
+                return false;
+            }
+            base = static_cast<std::byte*>(addr);
+            mapped_bytes = static_cast<std::size_t>(st.st_size);
+
+            const HistoryColumnHeader& h = header();
+            if (h.magic != HistoryColumnHeader::expected_magic ||
+                h.version != HistoryColumnHeader::current_version ||
+                (h.bits_used + 7) / 8 > mapped_bytes - sizeof(HistoryColumnHeader)) {
+                close(false);
+                return false;
+            }
+            return true;
+        }
+
+        /**
+         * @brief Unmap the file, optionally trimming it to the used stream bytes
+         */
+        void close(bool trim) {
+            std::size_t final_size = 0;
+            if (base) {
+                final_size = sizeof(HistoryColumnHeader) + static_cast<std::size_t>((header().bits_used + 7) / 8);
+                ::munmap(base, mapped_bytes);
+                base = nullptr;
+            }
+            if (fd >= 0) {
+                if (trim) {
+                    [[maybe_unused]] int rc = ::ftruncate(fd, static_cast<off_t>(final_size));
+                }
+                ::close(fd);
+                fd = -1;
+            }
+            mapped_bytes = 0;
+        }
+
+        /**
+         * @brief Publish a complete entry after its bits were written
+         */
+        void commit(std::uint64_t bits_used, std::uint64_t timestamp_ns) noexcept {
+            HistoryColumnHeader& h = header();
+            if (h.count == 0) {
+                h.first_ns = timestamp_ns;
+            }
+            h.last_ns = timestamp_ns;
+            std::atomic_ref<std::uint64_t>(h.bits_used).store(bits_used, std::memory_order_relaxed);
+            std::atomic_ref<std::uint64_t>(h.count).store(h.count + 1, std::memory_order_release);
+        }
+    };
+} // namespace detail
+
+/**
+ * @brief Stores selected cell values per tick in compressed column files
+ *
+ * Every segment consists of `<prefix>.<segment>.ts.frph` holding the tick
+ * timestamps and `<prefix>.<segment>.<I>.frph` for each stored cell I. Column
+ * files are sized for the worst case when a segment is created and trimmed to
+ * the compressed size when it is closed. Opening a historian starts a new
+ * history at the prefix.
+ *
+ * append() only writes into the mappings, except when a segment is full and
+ * the next one has to be created.
+ *
+ * @tparam Graph Reactive graph type
+ * @tparam Is Indices of the cells to store; values must be trivially copyable
+ *         and at most 64 bits wide
+ */
+template<typename Graph, std::size_t... Is>
+class Historian {
+private:
+    static constexpr std::size_t column_count = sizeof...(Is);
+
+    template<std::size_t I>
+    using value_t = std::remove_cvref_t<decltype(std::declval<const Graph&>().template get_cell<I>().value())>;
+
+    static_assert(column_count > 0, "Historian needs at least one cell");
+    static_assert((HistoryValue<value_t<Is>> && ...), "Stored cell values must be trivially copyable and at most 64 bits");
+
+    template<std::size_t I>
+    struct column {
+        static constexpr unsigned bits = static_cast<unsigned>(sizeof(value_t<I>) * 8);
+        detail::history_file file;
+        detail::bit_writer writer;
+        detail::xor_codec<bits> codec;
+    };
+
+    std::array<char, 256> prefix_{};
+    std::size_t ticks_per_segment_ = 0;
+    std::uint64_t segment_ = 0;
+    std::uint64_t ticks_in_segment_ = 0;
+
+    detail::history_file ts_file_;
+    detail::bit_writer ts_writer_;
+    detail::timestamp_codec ts_codec_;
+    std::tuple<column<Is>...> columns_;
+
+    template<std::size_t I>
+    static bool column_path(std::array<char, 256>& path, const char* prefix, std::uint64_t segment) {
+        char name[24];
+        std::snprintf(name, sizeof(name), "%zu", I);
+        return detail::history_column_path(path, prefix, segment, name);
+    }
+
+    template<std::size_t I>
+    bool open_column(column<I>& c) {
+        std::array<char, 256> path{};
+        if (!column_path<I>(path, prefix_.data(), segment_)) {
+            return false;
+        }
+        const std::size_t capacity = (ticks_per_segment_ * detail::xor_codec<column<I>::bits>::max_bits + 7) / 8;
+        if (!c.file.create(path, segment_, column<I>::bits, capacity)) {
+            return false;
+        }
+        c.writer = detail::bit_writer(c.file.stream(), 0);
+        c.codec = {};
+        return true;
+    }
+
+    bool open_segment() {
+        std::array<char, 256> path{};
+        if (!detail::history_column_path(path, prefix_.data(), segment_, "ts")) {
+            return false;
+        }
+        const std::size_t capacity = (ticks_per_segment_ * detail::timestamp_codec::max_bits + 7) / 8;
+        if (!ts_file_.create(path, segment_, 0, capacity)) {
+            return false;
+        }
+        ts_writer_ = detail::bit_writer(ts_file_.stream(), 0);
+        ts_codec_ = {};
+        ticks_in_segment_ = 0;
+        return std::apply([this](auto&... cs) { return (open_column(cs) && ...); }, columns_);
+    }
+
+    void close_segment() {
+        std::apply([](auto&... cs) { (cs.file.close(true), ...); }, columns_);
+        ts_file_.close(true);
+    }
+
+    template<std::size_t I>
+    void append_column(column<I>& c, const Graph& graph, std::uint64_t timestamp_ns) noexcept {
+        c.codec.encode(c.writer, detail::history_bits(graph.template get_cell<I>().value()));
+        c.file.commit(c.writer.position(), timestamp_ns);
+    }
+
+    template<std::size_t I, typename F>
+    std::size_t scan_segment(std::uint64_t segment, std::uint64_t from_ns, std::uint64_t to_ns, F& f) const {
+        std::array<char, 256> path{};
+        detail::history_file ts;
+        detail::history_file values;
+        if (!detail::history_column_path(path, prefix_.data(), segment, "ts") || !ts.map_read_only(path)) {
+            return 0;
+        }
+        if (!column_path<I>(path, prefix_.data(), segment) || !values.map_read_only(path)) {
+            ts.close(false);
+            return 0;
+        }
+
+        std::size_t visited = 0;
+        const std::uint64_t count = std::min(
+            std::atomic_ref<std::uint64_t>(values.header().count).load(std::memory_order_acquire),
+            std::atomic_ref<std::uint64_t>(ts.header().count).load(std::memory_order_acquire));
+        if (count > 0 && ts.header().first_ns <= to_ns && ts.header().last_ns >= from_ns) {
+            detail::bit_reader ts_in(ts.stream());
+            detail::bit_reader value_in(values.stream());
+            detail::timestamp_codec ts_codec;
+            detail::xor_codec<column<I>::bits> value_codec;
+            for (std::uint64_t i = 0; i < count; ++i) {
+                const std::uint64_t t = ts_codec.decode(ts_in);
+                const std::uint64_t bits = value_codec.decode(value_in);
+                if (t >= from_ns && t <= to_ns) {
+                    f(t, detail::history_value<value_t<I>>(bits));
+                    ++visited;
+                }
+            }
+        }
+        values.close(false);
+        ts.close(false);
+        return visited;
+    }
+
+public:
+    /**
+     * @brief Default number of ticks per segment
+     */
+    static constexpr std::size_t default_ticks_per_segment = 65536;
+
+    Historian() = default;
+    Historian(const Historian&) = delete;
+    Historian& operator=(const Historian&) = delete;
+
+    ~Historian() {
+        close();
+    }
+
+    /**
+     * @brief Start a new history and create its first segment
+     *
+     * @param prefix Path prefix of the column files
+     * @param ticks_per_segment Number of ticks stored per segment
+     * @return true if the first segment was created
+     */
+    bool open(const char* prefix, std::size_t ticks_per_segment = default_ticks_per_segment) {
+        close();
+        std::size_t len = std::strlen(prefix);
+        if (len + 1 > prefix_.size() || ticks_per_segment == 0) {
+            return false;
+        }
+        std::memcpy(prefix_.data(), prefix, len + 1);
+        ticks_per_segment_ = ticks_per_segment;
+        segment_ = 0;
+        if (!open_segment()) {
+            close_segment();
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Trim and close the current segment
+     */
+    void close() {
+        close_segment();
+    }
+
+    /**
+     * @brief Check whether the historian has an open segment
+     */
+    bool is_open() const noexcept {
+        return ts_file_.base != nullptr;
+    }
+
+    /**
+     * @brief Store the current values of the selected cells for one tick
+     *
+     * @param timestamp_ns Timestamp of the tick
+     * @param graph Graph to take the values from
+     * @return false if the next segment could not be created
+     */
+    bool append(std::uint64_t timestamp_ns, const Graph& graph) {
+        if (!is_open()) {
+            return false;
+        }
+        if (ticks_in_segment_ == ticks_per_segment_) {
+            close_segment();
+            ++segment_;
+            if (!open_segment()) {
+                close_segment();
+                return false;
+            }
+        }
+
+        std::apply([&](auto&... cs) { (append_column(cs, graph, timestamp_ns), ...); }, columns_);
+        // The timestamp column is committed last: a tick is complete once it appears there
+        ts_codec_.encode(ts_writer_, timestamp_ns);
+        ts_file_.commit(ts_writer_.position(), timestamp_ns);
+        ++ticks_in_segment_;
+        return true;
+    }
+
+    /**
+     * @brief Visit the stored values of one cell within a time range
+     *
+     * Segments whose time range does not overlap the query are skipped
+     * without decoding. Works while the historian is appending.
+     *
+     * @tparam I Index of the cell (must be one of Is)
+     * @param from_ns Start of the range (inclusive)
+     * @param to_ns End of the range (inclusive)
+     * @param f Called with (timestamp, value) in time order
+     * @return Number of values visited
+     */
+    template<std::size_t I, typename F>
+    std::size_t scan(std::uint64_t from_ns, std::uint64_t to_ns, F&& f) const {
+        static_assert(((I == Is) || ...), "Cell is not stored by this historian");
+        std::size_t visited = 0;
+        for (std::uint64_t segment = 0; segment <= segment_; ++segment) {
+            visited += scan_segment<I>(segment, from_ns, to_ns, f);
+        }
+        return visited;
+    }
+
+    /**
+     * @brief Number of the segment currently being written
+     */
+    std::uint64_t segment() const noexcept {
+        return segment_;
+    }
+};
+
+} // namespace frp
+
+#endif // FRP_HISTORY_HPP
@@ -0,0 +1,194 @@
+/**
+ * @file frp_layout_profile.hpp
+ * @brief Profile-guided element layout for FRP graphs
+ *
+ * This header supports a two-step workflow for large graphs whose
+ * declaration order has nothing to do with their access pattern:
+ * - An instrumented build uses frp::profiled_layout<AccessProfile<N>> as the
+ *   graph's layout policy; every cell read or written during a tick is recorded
+ * - At the end of each tick, AccessProfile::end_tick() adds the set of cells
+ *   touched together to a co-access matrix
+ * - write_header() orders the cells so that cells used together are adjacent
+ *   and emits a header defining an frp::explicit_layout with that order
+ * - The production build includes the generated header and uses the layout
+ *
+ * The profile lives in static storage (N * N counters), so it is meant for
+ * profiling builds and tools, not for the target.
+ */
+
+#ifndef FRP_LAYOUT_PROFILE_HPP
+#define FRP_LAYOUT_PROFILE_HPP
+
+#include "frp.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+namespace frp {
+
+/**
+ * @brief Records which cells of a graph are accessed together per tick
+ *
+ * All state is static, one profile per instantiation; use Tag to keep the
+ * profiles of several graphs apart. Not synchronized.
+ *
+ * @tparam MaxElements Upper bound on the number of graph elements
+ * @tparam Tag Distinguishes profiles of the same size
+ */
+template<std::size_t MaxElements, typename Tag = void>
+class AccessProfile {
+private:
+    // Cells placed next to the last few placed cells are likely in the same line
+    static constexpr std::size_t affinity_window = 4;
+
+    static inline std::array<bool, MaxElements> touched_{};
+    static inline std::array<std::uint32_t, MaxElements> tick_elements_{};
+    static inline std::size_t tick_count_ = 0;
+
+    static inline std::array<std::uint64_t, MaxElements> accesses_{};
+    static inline std::array<std::uint32_t, MaxElements * MaxElements> co_access_{};
+    static inline std::uint64_t ticks_ = 0;
+    static inline std::size_t elements_ = 0;
+
+public:
+    /**
+     * @brief Record an access to an element in the current tick
+     */
+    static void record(std::size_t element) noexcept {
+        if (element >= MaxElements || touched_[element]) {
+            return;
+        }
+        touched_[element] = true;
+        tick_elements_[tick_count_++] = static_cast<std::uint32_t>(element);
+        if (element >= elements_) {
+            elements_ = element + 1;
+        }
+    }
+
+    /**
+     * @brief Close the current tick and count its co-accesses
+     */
+    static void end_tick() noexcept {
+        for (std::size_t i = 0; i < tick_count_; ++i) {
+            const std::size_t a = tick_elements_[i];
+            ++accesses_[a];
+            for (std::size_t j = i + 1; j < tick_count_; ++j) {
+                const std::size_t b = tick_elements_[j];
+                ++co_access_[a * MaxElements + b];
+                ++co_access_[b * MaxElements + a];
+            }
+            touched_[a] = false;
+        }
+        tick_count_ = 0;
+        ++ticks_;
+    }
+
+    /**
+     * @brief Discard everything recorded so far
+     */
+    static void reset() noexcept {
+        touched_ = {};
+        tick_count_ = 0;
+        accesses_ = {};
+        co_access_ = {};
+        ticks_ = 0;
+        elements_ = 0;
+    }
+
+    /**
+     * @brief Number of completed ticks
+     */
+    static std::uint64_t ticks() noexcept {
+        return ticks_;
+    }
+
+    /**
+     * @brief Number of elements seen (highest recorded index + 1)
+     */
+    static std::size_t elements() noexcept {
+        return elements_;
+    }
+
+    /**
+     * @brief Number of ticks in which an element was accessed
+     */
+    static std::uint64_t accesses(std::size_t element) noexcept {
+        return element < MaxElements ? accesses_[element] : 0;
+    }
+
+    /**
+     * @brief Number of ticks in which two elements were both accessed
+     */
+    static std::uint32_t co_access(std::size_t a, std::size_t b) noexcept {
+        return a < MaxElements && b < MaxElements ? co_access_[a * MaxElements + b] : 0;
+    }
+
+    /**
+     * @brief Storage order of the elements seen, cells used together adjacent
+     *
+     * Greedy chaining: start with the most accessed element, then repeatedly
+     * append the element most often accessed together with the last few
+     * placed ones (ties: more accesses first, then lower index). Elements
+     * never accessed end up last, in index order.
+     *
+     * @return Element indices in storage order; the first elements() are valid
+     */
+    static std::array<std::size_t, MaxElements> order() noexcept {
+        std::array<std::size_t, MaxElements> result{};
+        std::array<bool, MaxElements> placed{};
+        const std::size_t n = elements_;
+
+        for (std::size_t k = 0; k < n; ++k) {
+            std::size_t best = n;
+            std::uint64_t best_score = 0;
+            for (std::size_t e = 0; e < n; ++e) {
+                if (placed[e]) {
+                    continue;
+                }
+                std::uint64_t score = 0;
+                for (std::size_t w = k > affinity_window ? k - affinity_window : 0; w < k; ++w) {
+                    score += co_access_[result[w] * MaxElements + e];
+                }
+                if (best == n || score > best_score ||
+                    (score == best_score && accesses_[e] > accesses_[best])) {
+                    best = e;
+                    best_score = score;
+                }
+            }
+            result[k] = best;
+            placed[best] = true;
+        }
+        return result;
+    }
+
+    /**
+     * @brief Write a header defining an explicit_layout with order()
+     *
+     * @param path Output file
+     * @param name Name of the layout alias, e.g. "controller_layout"
+     * @return true if the file was written
+     */
+    static bool write_header(const char* path, const char* name) {
+        std::FILE* file = std::fopen(path, "w");
+        if (!file) {
+            return false;
+        }
+        const std::array<std::size_t, MaxElements> storage = order();
+
+        std::fprintf(file, "// Generated by frp::AccessProfile from %llu ticks; do not edit.\n",
+                     static_cast<unsigned long long>(ticks_));
+        std::fprintf(file, "#pragma once\n\n#include \"frp.hpp\"\n\n");
+        std::fprintf(file, "using %s = frp::explicit_layout<", name);
+        for (std::size_t k = 0; k < elements_; ++k) {
+            std::fprintf(file, "%s%zu", k == 0 ? "" : (k % 16 == 0 ? ",\n    " : ", "), storage[k]);
+        }
+        std::fprintf(file, ">;\n");
+        return std::fclose(file) == 0;
+    }
+};
+
+} // namespace frp
+
+#endif // FRP_LAYOUT_PROFILE_HPP
@@ -0,0 +1,428 @@
+/**
+ * @file frp_persistent.hpp
+ * @brief Persistent copy-on-write arrays for large cell values
+ *
+ * A cell holding a large table (a calibration lookup table, a configuration
+ * block) that changes rarely but is read by many nodes and threads should
+ * not be copied whole on every change. persistent_array stores its elements
+ * in a fixed-depth tree of pool nodes shared between versions:
+ * - Copying an array takes a reference to its root; no elements are copied
+ * - set() copies only the nodes on the path to the changed element that are
+ *   shared with another version, and changes unshared nodes in place
+ * - A copy is a snapshot: it never observes later changes to the original,
+ *   so a reader thread that holds one can keep reading it without locks
+ *
+ * Nodes come from a static pool per element type, branching factor and pool
+ * size, sized at compile time; set() reports exhaustion by returning false.
+ * Reference counts and the pool's free list are atomic, so versions may be
+ * copied and destroyed on any thread. A single version must still not be
+ * written and read concurrently; hand readers a copy instead.
+ */
+
+#ifndef FRP_PERSISTENT_HPP
+#define FRP_PERSISTENT_HPP
+
+#include "frp.hpp"
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+
+namespace frp {
+
+namespace detail {
+    /**
+     * @brief Number of inner levels above the leaves of a tree of N elements
+     */
+    constexpr std::size_t cow_depth(std::size_t n, std::size_t branch) {
+        const std::size_t leaves = (n + branch - 1) / branch;
+        std::size_t depth = 0;
+        for (std::size_t reach = 1; reach < leaves; reach *= branch) {
+            ++depth;
+        }
+        return depth;
+    }
+
+    /**
+     * @brief Number of nodes of a tree of N elements in which nothing is shared
+     */
+    constexpr std::size_t cow_tree_nodes(std::size_t n, std::size_t branch) {
+        std::size_t count = (n + branch - 1) / branch;
+        std::size_t total = count;
+        while (count > 1) {
+            count = (count + branch - 1) / branch;
+            total += count;
+        }
+        return total;
+    }
+
+    /**
+     * @brief Static, lock-free pool of reference-counted tree nodes
+     *
+     * Nodes are addressed by 32-bit index. Freed nodes go onto a Treiber
+     * stack whose head carries a tag against ABA; nodes never handed out are
+     * taken from a bump index.
+     */
+    template<typename T, std::size_t Branch, std::size_t Nodes>
+    class cow_pool {
+    public:
+        static constexpr std::uint32_t null = 0xFFFFFFFFu;
+
+        union payload {
+            std::array<std::uint32_t, Branch> children;
+            std::array<T, Branch> items;
+        };
+
+        struct node {
+            std::atomic<std::uint32_t> refs{0};
+            std::atomic<std::uint32_t> next_free{null};
+            payload data{};
+        };
+
+    private:
+        static inline std::array<node, Nodes> nodes_{};
+        static inline std::atomic<std::uint64_t> free_head_{null}; // (tag << 32) | index
+        static inline std::atomic<std::uint32_t> unused_{0};
+        static inline std::atomic<std::uint32_t> in_use_{0};
+
+        static std::uint32_t claim(std::uint32_t index) noexcept {
+            nodes_[index].refs.store(1, std::memory_order_relaxed);
+            in_use_.fetch_add(1, std::memory_order_relaxed);
+            return index;
+        }
+
+        static void push_free(std::uint32_t index) noexcept {
+            in_use_.fetch_sub(1, std::memory_order_relaxed);
+            std::uint64_t head = free_head_.load(std::memory_order_relaxed);
+            std::uint64_t replacement;
+            do {
+                nodes_[index].next_free.store(static_cast<std::uint32_t>(head), std::memory_order_relaxed);
+                replacement = (((head >> 32) + 1) << 32) | index;
+            } while (!free_head_.compare_exchange_weak(head, replacement,
+                                                       std::memory_order_release,
+                                                       std::memory_order_relaxed));
+        }
+
+    public:
+        static node& at(std::uint32_t index) noexcept {
+            return nodes_[index];
+        }
+
+        /**
+         * @brief Take a node with one reference, or null if the pool is exhausted
+         */
+        static std::uint32_t allocate() noexcept {
+            std::uint64_t head = free_head_.load(std::memory_order_acquire);
+            while (static_cast<std::uint32_t>(head) != null) {
+                const std::uint32_t index = static_cast<std::uint32_t>(head);
+                const std::uint32_t next = nodes_[index].next_free.load(std::memory_order_relaxed);
+                const std::uint64_t replacement = (((head >> 32) + 1) << 32) | next;
+                if (free_head_.compare_exchange_weak(head, replacement,
+                                                     std::memory_order_acquire,
+                                                     std::memory_order_acquire)) {
+                    return claim(index);
+                }
+            }
+            std::uint32_t fresh = unused_.load(std::memory_order_relaxed);
+            while (fresh < Nodes) {
+                if (unused_.compare_exchange_weak(fresh, fresh + 1, std::memory_order_relaxed)) {
+                    return claim(fresh);
+                }
+            }
+            return null;
+        }
+
+        static void retain(std::uint32_t index) noexcept {
+            nodes_[index].refs.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Drop a reference; the last one frees the node and its subtree
+         *
+         * @param height Levels below the node (0 for a leaf)
+         */
+        static void release(std::uint32_t index, std::size_t height) noexcept {
+            if (nodes_[index].refs.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+                return;
+            }
+            if (height > 0) {
+                for (std::uint32_t child : nodes_[index].data.children) {
+                    release(child, height - 1);
+                }
+            }
+            push_free(index);
+        }
+
+        static std::size_t in_use() noexcept {
+            return in_use_.load(std::memory_order_relaxed);
+        }
+    };
+} // namespace detail
+
+/**
+ * @brief Fixed-size array with structural sharing between copies
+ *
+ * @code
+ * using Table = frp::persistent_array<std::uint16_t, 32768>; // 64 KB
+ * frp::Cell<Table> table{Table{}};
+ *
+ * Table snapshot = table.value(); // shares every node
+ * table.modify([](Table& t) { t.set(1200, 512); }); // copies one path
+ * @endcode
+ *
+ * Elements are stored in leaves of Branch elements under a tree of depth
+ * levels, so reading an element follows depth + 1 nodes and a change copies
+ * at most depth + 1 nodes, whatever N is.
+ *
+ * Not trivially copyable, so a graph holding one has no checkpoint support.
+ *
+ * @tparam T Element type; must be trivially copyable
+ * @tparam N Number of elements
+ * @tparam PoolNodes Nodes in the pool shared by all arrays of this type;
+ *         the default fits two fully unshared versions
+ * @tparam Branch Children per node and elements per leaf; a power of two
+ */
+template<typename T, std::size_t N,
+         std::size_t PoolNodes = 2 * detail::cow_tree_nodes(N, 16),
+         std::size_t Branch = 16>
+class persistent_array {
+    static_assert(std::is_trivially_copyable_v<T> && std::is_default_constructible_v<T>,
+                  "persistent_array elements must be trivially copyable");
+    static_assert(N > 0, "persistent_array must not be empty");
+    static_assert(std::has_single_bit(Branch) && Branch >= 2, "Branch must be a power of two");
+    static_assert(PoolNodes < 0xFFFFFFFFu, "PoolNodes must fit a 32-bit index");
+
+private:
+    using pool = detail::cow_pool<T, Branch, PoolNodes>;
+
+    static constexpr std::size_t depth = detail::cow_depth(N, Branch);
+    static constexpr std::size_t bits = std::countr_zero(Branch);
+
+    std::uint32_t root_ = pool::null;
+
+    static std::size_t digit(std::size_t index, std::size_t level) noexcept {
+        return (index >> (bits * (depth - level))) & (Branch - 1);
+    }
+
+    void reset() noexcept {
+        if (root_ != pool::null) {
+            pool::release(root_, depth);
+            root_ = pool::null;
+        }
+    }
+
+public:
+    using value_type = T;
+
+    /**
+     * @brief Zero-initialized array of depth + 1 nodes, all shared
+     *
+     * Invalid (see valid()) if the pool is exhausted.
+     */
+    persistent_array() noexcept {
+        std::uint32_t child = pool::allocate();
+        if (child == pool::null) {
+            return;
+        }
+        pool::at(child).data.items.fill(T{});
+        for (std::size_t level = 0; level < depth; ++level) {
+            const std::uint32_t parent = pool::allocate();
+            if (parent == pool::null) {
+                pool::release(child, level);
+                return;
+            }
+            pool::at(parent).data.children.fill(child);
+            pool::at(child).refs.fetch_add(Branch - 1, std::memory_order_relaxed);
+            child = parent;
+        }
+        root_ = child;
+    }
+
+    /**
+     * @brief Array holding the given values, zero after them
+     */
+    explicit persistent_array(std::span<const T> values) noexcept : persistent_array() {
+        for (std::size_t i = 0; i < values.size() && i < N; ++i) {
+            if (!set(i, values[i])) {
+                reset();
+                return;
+            }
+        }
+    }
+
+    persistent_array(const persistent_array& other) noexcept : root_(other.root_) {
+        if (root_ != pool::null) {
+            pool::retain(root_);
+        }
+    }
+
+    persistent_array(persistent_array&& other) noexcept : root_(other.root_) {
+        other.root_ = pool::null;
+    }
+
+    persistent_array& operator=(const persistent_array& other) noexcept {
+        if (other.root_ != pool::null) {
+            pool::retain(other.root_);
+        }
+        reset();
+        root_ = other.root_;
+        return *this;
+    }
+
+    persistent_array& operator=(persistent_array&& other) noexcept {
+        if (this != &other) {
+            reset();
+            root_ = other.root_;
+            other.root_ = pool::null;
+        }
+        return *this;
+    }
+
+    ~persistent_array() {
+        reset();
+    }
+
+    /**
+     * @brief Check that the array has storage
+     *
+     * False only if construction ran out of pool nodes or after a move.
+     */
+    bool valid() const noexcept {
+        return root_ != pool::null;
+    }
+
+    static constexpr std::size_t size() noexcept {
+        return N;
+    }
+
+    /**
+     * @brief Element at an index; T{} for an invalid array
+     */
+    const T& operator[](std::size_t index) const noexcept {
+        static const T empty{};
+        if (root_ == pool::null || index >= N) {
+            return empty;
+        }
+        std::uint32_t node = root_;
+        for (std::size_t level = 0; level < depth; ++level) {
+            node = pool::at(node).data.children[digit(index, level)];
+        }
+        return pool::at(node).data.items[index & (Branch - 1)];
+    }
+
+    T get(std::size_t index) const noexcept {
+        return (*this)[index];
+    }
+
+    /**
+     * @brief Change one element, copying the shared nodes on its path
+     *
+     * Copies made by other holders keep the previous value.
+     *
+     * @return false if the index is out of range, the array is invalid, or
+     *         the pool ran out of nodes (the array is then unchanged)
+     */
+    bool set(std::size_t index, const T& value) noexcept {
+        if (root_ == pool::null || index >= N) {
+            return false;
+        }
+        std::uint32_t* slot = &root_;
+        for (std::size_t level = 0;; ++level) {
+            std::uint32_t node = *slot;
+            if (pool::at(node).refs.load(std::memory_order_acquire) != 1) {
+                const std::uint32_t copy = pool::allocate();
+                if (copy == pool::null) {
+                    return false;
+                }
+                pool::at(copy).data = pool::at(node).data;
+                if (level < depth) {
+                    for (std::uint32_t child : pool::at(copy).data.children) {
+                        pool::retain(child);
+                    }
+                }
+                pool::release(node, depth - level);
+                *slot = copy;
+                node = copy;
+            }
+            if (level == depth) {
+                pool::at(node).data.items[index & (Branch - 1)] = value;
+                return true;
+            }
+            slot = &pool::at(node).data.children[digit(index, level)];
+        }
+    }
+
+    /**
+     * @brief Change one element in place with f(T&)
+     */
+    template<typename F>
+    bool update(std::size_t index, F&& f) noexcept {
+        T value = get(index);
+        f(value);
+        return set(index, value);
+    }
+
+    /**
+     * @brief Check whether two arrays are the same version
+     *
+     * Constant time; a cheap way for a reader to notice that its snapshot is
+     * out of date. Equal contents built separately are not identical.
+     */
+    bool identical(const persistent_array& other) const noexcept {
+        return root_ == other.root_;
+    }
+
+    friend bool operator==(const persistent_array& a, const persistent_array& b) noexcept
+        requires std::equality_comparable<T> {
+        if (a.identical(b)) {
+            return true;
+        }
+        for (std::size_t i = 0; i < N; ++i) {
+            if (!(a[i] == b[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Pool nodes in use by all arrays of this type
+     */
+    static std::size_t pool_in_use() noexcept {
+        return pool::in_use();
+    }
+
+    static constexpr std::size_t pool_capacity() noexcept {
+        return PoolNodes;
+    }
+
+    /**
+     * @brief Nodes read by operator[] (depth + 1)
+     */
+    static constexpr std::size_t path_length() noexcept {
+        return depth + 1;
+    }
+
+    static constexpr std::size_t pool_bytes() noexcept {
+        return PoolNodes * sizeof(typename pool::node);
+    }
+};
+
+/**
+ * @brief The array handle is a value; its pool is external static storage
+ */
+template<typename T, std::size_t N, std::size_t PoolNodes, std::size_t Branch>
+struct memory_traits<persistent_array<T, N, PoolNodes, Branch>> {
+    static constexpr memory_usage usage{
+        sizeof(persistent_array<T, N, PoolNodes, Branch>), 0, 0,
+        persistent_array<T, N, PoolNodes, Branch>::pool_bytes()};
+};
+
+} // namespace frp
+
+#endif // FRP_PERSISTENT_HPP
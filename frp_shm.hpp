@@ -0,0 +1,244 @@
+/**
+ * @file frp_shm.hpp
+ * @brief Shared-memory adapters for FRP graphs (POSIX)
+ *
+ * This header connects graphs to other processes through POSIX shared memory:
+ * - ShmPublisher mirrors selected cells into a segment under a seqlock
+ * - Other processes read the values with frp::ShmReader (frp_shm_reader.hpp)
+ * - Sensor samples from other processes arrive through an SPSC ring
+ *   (frp::ShmRingProducer / frp::ShmRingConsumer, frp_shm_ring.hpp)
+ *
+ * Publishing is a handful of memcpy calls and two stores to the sequence
+ * counter; there is no serialization and no syscall per publish.
+ */
+
+#ifndef FRP_SHM_HPP
+#define FRP_SHM_HPP
+
+#include "frp.hpp"
+#include "frp_shm_reader.hpp"
+#include "frp_shm_ring.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace frp {
+
+namespace detail {
+    /**
+     * @brief Round an offset up to an alignment
+     */
+    constexpr std::size_t align_up(std::size_t offset, std::size_t alignment) noexcept {
+        return (offset + alignment - 1) / alignment * alignment;
+    }
+
+    /**
+     * @brief Value type of cell I of a graph
+     */
+    template<typename Graph, std::size_t I>
+    using graph_value_t = std::remove_cvref_t<
+        decltype(std::declval<const Graph&>().template get_cell<I>().value())>;
+} // namespace detail
+
+/**
+ * @brief Mirrors selected cells of a graph into a shared-memory segment
+ *
+ * The segment holds a header, a slot table describing every published cell
+ * (node id = cell index, size, offset) and a data area with the values. Each
+ * publish() copies all selected values under one seqlock write, so readers
+ * always see the values of a single tick together.
+ *
+ * @tparam Graph Reactive graph type
+ * @tparam Is Indices of the cells to publish; their values must be trivially copyable
+ */
+template<typename Graph, std::size_t... Is>
+class ShmPublisher {
+private:
+    static constexpr std::size_t slot_count = sizeof...(Is);
+
+    static_assert(slot_count > 0, "ShmPublisher needs at least one cell");
+    static_assert((std::is_trivially_copyable_v<detail::graph_value_t<Graph, Is>> && ...),
+                  "Published cell values must be trivially copyable");
+
+    static constexpr std::array<std::size_t, slot_count> sizes{sizeof(detail::graph_value_t<Graph, Is>)...};
+
+    static constexpr std::array<std::size_t, slot_count> offsets = [] {
+        constexpr std::array<std::size_t, slot_count> aligns{alignof(detail::graph_value_t<Graph, Is>)...};
+        std::array<std::size_t, slot_count> result{};
+        std::size_t offset = 0;
+        for (std::size_t i = 0; i < slot_count; ++i) {
+            offset = detail::align_up(offset, aligns[i]);
+            result[i] = offset;
+            offset += sizes[i];
+        }
+        return result;
+    }();
+
+    static constexpr std::size_t data_size = offsets[slot_count - 1] + sizes[slot_count - 1];
+    static constexpr std::size_t data_offset =
+        detail::align_up(sizeof(ShmOutputHeader) + slot_count * sizeof(ShmOutputSlot), 64);
+    static constexpr std::size_t segment_size = data_offset + data_size;
+
+    std::byte* base_ = nullptr;
+    std::array<char, 256> name_{};
+
+    ShmOutputHeader& header() noexcept {
+        return *reinterpret_cast<ShmOutputHeader*>(base_);
+    }
+
+    template<std::size_t K, std::size_t I>
+    void copy_value(const Graph& graph) noexcept {
+        const auto& value = graph.template get_cell<I>().value();
+        std::memcpy(base_ + data_offset + offsets[K], &value, sizes[K]);
+    }
+
+    template<std::size_t... Ks>
+    void copy_values(const Graph& graph, std::index_sequence<Ks...>) noexcept {
+        (copy_value<Ks, Is>(graph), ...);
+    }
+
+public:
+    ShmPublisher() = default;
+    ShmPublisher(const ShmPublisher&) = delete;
+    ShmPublisher& operator=(const ShmPublisher&) = delete;
+
+    ~ShmPublisher() {
+        close();
+    }
+
+    /**
+     * @brief Create (or replace) the shared-memory segment and write its layout
+     *
+     * The segment is tagged with the graph's topology hash so readers can check
+     * which graph they are attached to.
+     *
+     * @param name Name of the shared-memory object (e.g. "/controller.outputs")
+     * @return true if the segment was created and mapped
+     */
+    bool open(const char* name) {
+        close();
+
+        std::size_t len = std::strlen(name);
+        if (len + 1 > name_.size()) {
+            return false;
+        }
+        std::memcpy(name_.data(), name, len + 1);
+
+        int fd = ::shm_open(name, O_RDWR | O_CREAT, 0644);
+        if (fd < 0) {
+            return false;
+        }
+        if (::ftruncate(fd, static_cast<off_t>(segment_size)) != 0) {
+            ::close(fd);
+            return false;
+        }
+        void* addr = ::mmap(nullptr, segment_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (addr == MAP_FAILED) {
+            return false;
+        }
+        base_ = static_cast<std::byte*>(addr);
+
+        // Invalidate the header while the layout is rewritten so readers
+        // attached to an older publisher reject the segment.
+        ShmOutputHeader* h = ::new (base_) ShmOutputHeader{};
+        h->version = ShmOutputHeader::current_version;
+        h->slot_count = static_cast<std::uint32_t>(slot_count);
+        h->topology_hash = Graph::topology_hash();
+        h->data_offset = data_offset;
+        h->data_size = data_size;
+        h->sequence.store(0, std::memory_order_relaxed);
+
+        constexpr std::array<std::uint32_t, slot_count> node_ids{static_cast<std::uint32_t>(Is)...};
+        auto* slots = reinterpret_cast<ShmOutputSlot*>(base_ + sizeof(ShmOutputHeader));
+        for (std::size_t i = 0; i < slot_count; ++i) {
+            slots[i] = ShmOutputSlot{node_ids[i], static_cast<std::uint32_t>(sizes[i]), offsets[i]};
+        }
+        std::memset(base_ + data_offset, 0, data_size);
+
+        std::atomic_thread_fence(std::memory_order_release);
+        h->magic = ShmOutputHeader::expected_magic;
+        return true;
+    }
+
+    /**
+     * @brief Unmap the segment; the shared-memory object stays available
+     */
+    void close() {
+        if (base_) {
+            ::munmap(base_, segment_size);
+            base_ = nullptr;
+        }
+    }
+
+    /**
+     * @brief Remove the shared-memory object name
+     */
+    bool unlink() {
+        return name_[0] != '\0' && ::shm_unlink(name_.data()) == 0;
+    }
+
+    /**
+     * @brief Check whether a segment is mapped
+     */
+    bool is_open() const noexcept {
+        return base_ != nullptr;
+    }
+
+    /**
+     * @brief Copy the current values of the selected cells into the segment
+     *
+     * Call once per tick after the graph has been updated.
+     */
+    void publish(const Graph& graph) noexcept {
+        std::atomic<std::uint64_t>& seq = header().sequence;
+        const std::uint64_t s = seq.load(std::memory_order_relaxed);
+        seq.store(s + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        copy_values(graph, std::make_index_sequence<slot_count>{});
+
+        seq.store(s + 2, std::memory_order_release);
+    }
+
+    /**
+     * @brief Size of the shared-memory segment in bytes
+     */
+    static constexpr std::size_t size() noexcept {
+        return segment_size;
+    }
+};
+
+/**
+ * @brief Published values and ring slots live in mapped segments, outside the object
+ */
+template<typename Graph, std::size_t... Is>
+struct memory_traits<ShmPublisher<Graph, Is...>> {
+    static constexpr memory_usage usage{sizeof(ShmPublisher<Graph, Is...>), 0, 0,
+                                        ShmPublisher<Graph, Is...>::size()};
+};
+
+template<typename T, std::size_t Capacity>
+struct memory_traits<ShmRingProducer<T, Capacity>> {
+    static constexpr memory_usage usage{sizeof(ShmRingProducer<T, Capacity>), 0, 0,
+                                        ShmRingProducer<T, Capacity>::mapped_size()};
+};
+
+template<typename T, std::size_t Capacity>
+struct memory_traits<ShmRingConsumer<T, Capacity>> {
+    static constexpr memory_usage usage{sizeof(ShmRingConsumer<T, Capacity>), 0, 0,
+                                        ShmRingConsumer<T, Capacity>::mapped_size()};
+};
+
+} // namespace frp
+
+#endif // FRP_SHM_HPP
@@ -0,0 +1,271 @@
+/**
+ * @file frp_shm_reader.hpp
+ * @brief Reader for graph outputs published to POSIX shared memory
+ *
+ * This header is self-contained (standard library and POSIX only) so that
+ * HMI, historian and diagnostics processes can read live values published by
+ * frp::ShmPublisher without depending on the rest of the library:
+ * - The segment is mapped read-only; readers never write to it
+ * - Values are read under a seqlock, so a read never blocks the publisher
+ * - A read returns a consistent snapshot of one publish() call
+ */
+
+#ifndef FRP_SHM_READER_HPP
+#define FRP_SHM_READER_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace frp {
+
+/**
+ * @brief Header at the start of a shared-memory output segment
+ *
+ * The sequence counter lives on its own cache line: it is odd while the
+ * publisher is copying values and is advanced by two per publish.
+ */
+struct ShmOutputHeader {
+    std::array<char, 8> magic;
+    std::uint32_t version;
+    std::uint32_t slot_count;
+    std::uint64_t topology_hash;
+    std::uint64_t data_offset;
+    std::uint64_t data_size;
+    alignas(64) std::atomic<std::uint64_t> sequence;
+
+    static constexpr std::array<char, 8> expected_magic{'F', 'R', 'P', 'S', 'H', 'M', 'O', 0};
+    static constexpr std::uint32_t current_version = 1;
+};
+
+static_assert(sizeof(ShmOutputHeader) == 128, "Shared-memory output header must stay two cache lines");
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free,
+              "Shared-memory sequence counter must be lock-free");
+
+/**
+ * @brief Entry of the slot table that follows the header
+ */
+struct ShmOutputSlot {
+    std::uint32_t node_id;
+    std::uint32_t size;
+    std::uint64_t offset;  ///< Offset of the value from the start of the data area
+};
+
+/**
+ * @brief Read-only view of a shared-memory output segment
+ *
+ * Reads copy values out under the seqlock and retry while the publisher is
+ * writing. A read gives up after a bounded number of attempts so a reader can
+ * never spin forever on a stalled publisher.
+ */
+class ShmReader {
+private:
+    const std::byte* base_ = nullptr;
+    std::size_t mapped_bytes_ = 0;
+
+    const ShmOutputHeader& header() const noexcept {
+        return *reinterpret_cast<const ShmOutputHeader*>(base_);
+    }
+
+    const ShmOutputSlot* slots() const noexcept {
+        return reinterpret_cast<const ShmOutputSlot*>(base_ + sizeof(ShmOutputHeader));
+    }
+
+    const std::byte* data() const noexcept {
+        return base_ + header().data_offset;
+    }
+
+public:
+    /**
+     * @brief Default number of attempts of a read before it gives up
+     */
+    static constexpr int default_attempts = 1000;
+
+    ShmReader() = default;
+    ShmReader(const ShmReader&) = delete;
+    ShmReader& operator=(const ShmReader&) = delete;
+
+    ~ShmReader() {
+        close();
+    }
+
+    /**
+     * @brief Map a published segment by its shared-memory object name
+     *
+     * @param name Name of the object (e.g. "/controller.outputs")
+     * @return true if the segment exists and has a matching layout
+     */
+    bool open(const char* name) {
+        close();
+
+        int fd = ::shm_open(name, O_RDONLY, 0);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat st{};
+        if (::fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < sizeof(ShmOutputHeader)) {
+            ::close(fd);
+            return false;
+        }
+        void* addr = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (addr == MAP_FAILED) {
+            return false;
+        }
+        base_ = static_cast<const std::byte*>(addr);
+        mapped_bytes_ = static_cast<std::size_t>(st.st_size);
+
+        const ShmOutputHeader& h = header();
+        if (h.magic != ShmOutputHeader::expected_magic ||
+            h.version != ShmOutputHeader::current_version ||
+            sizeof(ShmOutputHeader) + h.slot_count * sizeof(ShmOutputSlot) > h.data_offset ||
+            h.data_offset + h.data_size > mapped_bytes_) {
+            close();
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Unmap the segment
+     */
+    void close() {
+        if (base_) {
+            ::munmap(const_cast<std::byte*>(base_), mapped_bytes_);
+            base_ = nullptr;
+        }
+        mapped_bytes_ = 0;
+    }
+
+    /**
+     * @brief Check whether a segment is mapped
+     */
+    bool is_open() const noexcept {
+        return base_ != nullptr;
+    }
+
+    /**
+     * @brief Topology hash of the publishing graph
+     */
+    std::uint64_t topology_hash() const noexcept {
+        return header().topology_hash;
+    }
+
+    /**
+     * @brief Number of published values
+     */
+    std::size_t slot_count() const noexcept {
+        return header().slot_count;
+    }
+
+    /**
+     * @brief Slot table entry of a published value
+     */
+    const ShmOutputSlot& slot(std::size_t index) const noexcept {
+        return slots()[index];
+    }
+
+    /**
+     * @brief Size of the data area, i.e. of a full snapshot
+     */
+    std::size_t data_size() const noexcept {
+        return static_cast<std::size_t>(header().data_size);
+    }
+
+    /**
+     * @brief Number of completed publishes so far
+     */
+    std::uint64_t publish_count() const noexcept {
+        return header().sequence.load(std::memory_order_acquire) / 2;
+    }
+
+    /**
+     * @brief Find the slot index of a node id
+     *
+     * @return The slot index, or slot_count() if the node is not published
+     */
+    std::size_t find(std::uint32_t node_id) const noexcept {
+        const std::size_t n = slot_count();
+        for (std::size_t i = 0; i < n; ++i) {
+            if (slots()[i].node_id == node_id) {
+                return i;
+            }
+        }
+        return n;
+    }
+
+    /**
+     * @brief Consistently copy a byte range of the data area
+     *
+     * @param offset Offset into the data area
+     * @param out Destination buffer; its size is the number of bytes copied
+     * @param attempts Maximum number of seqlock retries
+     * @return The publish count of the copied data, or 0 if no consistent copy
+     *         could be taken (or nothing was published yet)
+     */
+    std::uint64_t read_bytes(std::size_t offset, std::span<std::byte> out,
+                             int attempts = default_attempts) const noexcept {
+        if (offset + out.size() > data_size()) {
+            return 0;
+        }
+        const std::atomic<std::uint64_t>& seq = header().sequence;
+        for (int i = 0; i < attempts; ++i) {
+            std::uint64_t before = seq.load(std::memory_order_acquire);
+            if (before & 1u) {
+                continue;
+            }
+            std::memcpy(out.data(), data() + offset, out.size());
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (seq.load(std::memory_order_relaxed) == before) {
+                return before / 2;
+            }
+        }
+        return 0;
+    }
+
+    /**
+     * @brief Consistently copy the whole data area
+     *
+     * @return The publish count of the snapshot, or 0 on failure
+     */
+    std::uint64_t snapshot(std::span<std::byte> out, int attempts = default_attempts) const noexcept {
+        return read_bytes(0, out.first(std::min(out.size(), data_size())), attempts);
+    }
+
+    /**
+     * @brief Consistently read a single published value
+     *
+     * @param node_id Node id of the value
+     * @param out Receives the value
+     * @return true if the node is published with a matching size and a
+     *         consistent value was read
+     */
+    template<typename T>
+        requires std::is_trivially_copyable_v<T>
+    bool read(std::uint32_t node_id, T& out, int attempts = default_attempts) const noexcept {
+        std::size_t index = find(node_id);
+        if (index == slot_count() || slots()[index].size != sizeof(T)) {
+            return false;
+        }
+        std::array<std::byte, sizeof(T)> bytes;
+        if (read_bytes(static_cast<std::size_t>(slots()[index].offset), bytes, attempts) == 0) {
+            return false;
+        }
+        std::memcpy(&out, bytes.data(), sizeof(T));
+        return true;
+    }
+};
+
+} // namespace frp
+
+#endif // FRP_SHM_READER_HPP
@@ -0,0 +1,383 @@
+/**
+ * @file frp_shm_ring.hpp
+ * @brief Single-producer single-consumer ring in POSIX shared memory
+ *
+ * This header is self-contained (standard library and POSIX only) so that an
+ * acquisition process can feed sensor samples to a graph process without
+ * depending on the rest of the library:
+ * - The producer writes samples straight into ring slots in shared memory
+ * - The consumer reads them in place and writes them into input cells
+ * - Head and tail live on separate cache lines; each side caches the other's
+ *   index so the shared lines are only touched when the cache runs out
+ */
+
+#ifndef FRP_SHM_RING_HPP
+#define FRP_SHM_RING_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace frp {
+
+/**
+ * @brief Header at the start of a shared-memory ring segment
+ */
+struct ShmRingHeader {
+    std::array<char, 8> magic;
+    std::uint32_t version;
+    std::uint32_t element_size;
+    std::uint64_t capacity;
+    std::uint64_t data_offset;
+    alignas(64) std::atomic<std::uint64_t> head;  ///< Next slot the producer writes
+    alignas(64) std::atomic<std::uint64_t> tail;  ///< Next slot the consumer reads
+
+    static constexpr std::array<char, 8> expected_magic{'F', 'R', 'P', 'S', 'H', 'M', 'R', 0};
+    static constexpr std::uint32_t current_version = 1;
+};
+
+static_assert(sizeof(ShmRingHeader) == 192, "Shared-memory ring header must stay three cache lines");
+
+namespace detail {
+    /**
+     * @brief Mapping of a shared-memory ring shared by producer and consumer
+     *
+     * @tparam T Element type
+     * @tparam Capacity Number of slots (power of two)
+     */
+    template<typename T, std::size_t Capacity>
+    class shm_ring_mapping {
+    protected:
+        static_assert(std::is_trivially_copyable_v<T>, "Ring elements must be trivially copyable");
+        static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Ring capacity must be a power of two");
+
+        static constexpr std::size_t mask = Capacity - 1;
+        static constexpr std::size_t data_offset =
+            (sizeof(ShmRingHeader) + alignof(T) - 1) / alignof(T) * alignof(T);
+        static constexpr std::size_t segment_size = data_offset + Capacity * sizeof(T);
+
+        std::byte* base_ = nullptr;
+        std::array<char, 256> name_{};
+
+        ShmRingHeader& header() const noexcept {
+            return *reinterpret_cast<ShmRingHeader*>(base_);
+        }
+
+        T* slots() const noexcept {
+            return reinterpret_cast<T*>(base_ + data_offset);
+        }
+
+        bool map(const char* name, bool create) {
+            close();
+
+            std::size_t len = std::strlen(name);
+            if (len + 1 > name_.size()) {
+                return false;
+            }
+            std::memcpy(name_.data(), name, len + 1);
+
+            int fd = ::shm_open(name, create ? (O_RDWR | O_CREAT) : O_RDWR, 0644);
+            if (fd < 0) {
+                return false;
+            }
+            if (create) {
+                if (::ftruncate(fd, static_cast<off_t>(segment_size)) != 0) {
+                    ::close(fd);
+                    return false;
+                }
+            } else {
+                struct stat st{};
+                if (::fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < segment_size) {
+                    ::close(fd);
+                    return false;
+                }
+            }
+            void* addr = ::mmap(nullptr, segment_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            ::close(fd);
+            if (addr == MAP_FAILED) {
+                return false;
+            }
+            base_ = static_cast<std::byte*>(addr);
+
+            if (create) {
+                ShmRingHeader* h = ::new (base_) ShmRingHeader{};
+                h->version = ShmRingHeader::current_version;
+                h->element_size = sizeof(T);
+                h->capacity = Capacity;
+                h->data_offset = data_offset;
+                h->head.store(0, std::memory_order_relaxed);
+                h->tail.store(0, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_release);
+                h->magic = ShmRingHeader::expected_magic;
+                return true;
+            }
+
+            const ShmRingHeader& h = header();
+            if (h.magic != ShmRingHeader::expected_magic ||
+                h.version != ShmRingHeader::current_version ||
+                h.element_size != sizeof(T) || h.capacity != Capacity ||
+                h.data_offset != data_offset) {
+                close();
+                return false;
+            }
+            return true;
+        }
+
+    public:
+        shm_ring_mapping() = default;
+        shm_ring_mapping(const shm_ring_mapping&) = delete;
+        shm_ring_mapping& operator=(const shm_ring_mapping&) = delete;
+
+        ~shm_ring_mapping() {
+            close();
+        }
+
+        /**
+         * @brief Create (or reset) the ring segment
+         *
+         * Exactly one side creates the ring; the other side attaches to it.
+         */
+        bool create(const char* name) {
+            return map(name, true);
+        }
+
+        /**
+         * @brief Attach to an existing ring segment with a matching layout
+         */
+        bool attach(const char* name) {
+            return map(name, false);
+        }
+
+        /**
+         * @brief Unmap the segment; the shared-memory object stays available
+         */
+        void close() {
+            if (base_) {
+                ::munmap(base_, segment_size);
+                base_ = nullptr;
+            }
+        }
+
+        /**
+         * @brief Remove the shared-memory object name
+         */
+        bool unlink() {
+            return name_[0] != '\0' && ::shm_unlink(name_.data()) == 0;
+        }
+
+        /**
+         * @brief Check whether a segment is mapped
+         */
+        bool is_open() const noexcept {
+            return base_ != nullptr;
+        }
+
+        /**
+         * @brief Number of slots of the ring
+         */
+        static constexpr std::size_t capacity() noexcept {
+            return Capacity;
+        }
+
+        /**
+         * @brief Bytes of the shared-memory segment holding the ring
+         */
+        static constexpr std::size_t mapped_size() noexcept {
+            return segment_size;
+        }
+    };
+} // namespace detail
+
+/**
+ * @brief Producer side of a shared-memory SPSC ring
+ *
+ * Samples can be written in place with claim()/commit() or copied in with
+ * try_push(). Exactly one thread of one process may produce.
+ *
+ * @tparam T Element type (trivially copyable)
+ * @tparam Capacity Number of slots (power of two)
+ */
+template<typename T, std::size_t Capacity>
+class ShmRingProducer : public detail::shm_ring_mapping<T, Capacity> {
+private:
+    using base = detail::shm_ring_mapping<T, Capacity>;
+    using base::header;
+    using base::mask;
+    using base::slots;
+
+    std::uint64_t head_ = 0;
+    std::uint64_t cached_tail_ = 0;
+
+public:
+    /**
+     * @brief Create the ring and start producing into it
+     */
+    bool create(const char* name) {
+        head_ = 0;
+        cached_tail_ = 0;
+        return base::create(name);
+    }
+
+    /**
+     * @brief Attach to an existing ring and resume after its last sample
+     */
+    bool attach(const char* name) {
+        if (!base::attach(name)) {
+            return false;
+        }
+        head_ = header().head.load(std::memory_order_relaxed);
+        cached_tail_ = header().tail.load(std::memory_order_acquire);
+        return true;
+    }
+
+    /**
+     * @brief Get the next free slot to write a sample in place
+     *
+     * @return Pointer to the slot, or nullptr if the ring is full
+     */
+    T* claim() noexcept {
+        if (head_ - cached_tail_ == Capacity) {
+            cached_tail_ = header().tail.load(std::memory_order_acquire);
+            if (head_ - cached_tail_ == Capacity) {
+                return nullptr;
+            }
+        }
+        return &slots()[head_ & mask];
+    }
+
+    /**
+     * @brief Make the slot returned by claim() visible to the consumer
+     */
+    void commit() noexcept {
+        ++head_;
+        header().head.store(head_, std::memory_order_release);
+    }
+
+    /**
+     * @brief Copy a sample into the ring
+     *
+     * @return false if the ring is full
+     */
+    bool try_push(const T& value) noexcept {
+        T* slot = claim();
+        if (!slot) {
+            return false;
+        }
+        std::memcpy(static_cast<void*>(slot), &value, sizeof(T));
+        commit();
+        return true;
+    }
+};
+
+/**
+ * @brief Consumer side of a shared-memory SPSC ring
+ *
+ * Samples are read in place from shared memory; a whole batch is released to
+ * the producer with a single store of the tail index. Exactly one thread of
+ * one process may consume.
+ *
+ * @tparam T Element type (trivially copyable)
+ * @tparam Capacity Number of slots (power of two)
+ */
+template<typename T, std::size_t Capacity>
+class ShmRingConsumer : public detail::shm_ring_mapping<T, Capacity> {
+private:
+    using base = detail::shm_ring_mapping<T, Capacity>;
+    using base::header;
+    using base::mask;
+    using base::slots;
+
+    std::uint64_t tail_ = 0;
+    std::uint64_t cached_head_ = 0;
+
+public:
+    /**
+     * @brief Create the ring and start consuming from it
+     */
+    bool create(const char* name) {
+        tail_ = 0;
+        cached_head_ = 0;
+        return base::create(name);
+    }
+
+    /**
+     * @brief Attach to an existing ring and resume after the last consumed sample
+     */
+    bool attach(const char* name) {
+        if (!base::attach(name)) {
+            return false;
+        }
+        tail_ = header().tail.load(std::memory_order_relaxed);
+        cached_head_ = header().head.load(std::memory_order_acquire);
+        return true;
+    }
+
+    /**
+     * @brief Number of samples ready to be consumed
+     */
+    std::size_t available() noexcept {
+        cached_head_ = header().head.load(std::memory_order_acquire);
+        return static_cast<std::size_t>(cached_head_ - tail_);
+    }
+
+    /**
+     * @brief Visit up to max_count samples in place and release them
+     *
+     * @param f Called with a const reference into shared memory for each sample
+     * @param max_count Maximum number of samples to consume
+     * @return Number of samples consumed
+     */
+    template<typename F>
+    std::size_t consume(F&& f, std::size_t max_count = Capacity) {
+        if (cached_head_ == tail_) {
+            cached_head_ = header().head.load(std::memory_order_acquire);
+        }
+        std::size_t count = static_cast<std::size_t>(cached_head_ - tail_);
+        if (count > max_count) {
+            count = max_count;
+        }
+        for (std::size_t i = 0; i < count; ++i) {
+            f(static_cast<const T&>(slots()[(tail_ + i) & mask]));
+        }
+        if (count > 0) {
+            tail_ += count;
+            header().tail.store(tail_, std::memory_order_release);
+        }
+        return count;
+    }
+
+    /**
+     * @brief Consume all pending samples and write the newest into an input cell
+     *
+     * Older samples are released without being copied. Works with any graph
+     * whose cell I has `set_value(T)`.
+     *
+     * @tparam I Index of the input cell
+     * @param graph Graph owning the cell
+     * @return true if a sample was written
+     */
+    template<std::size_t I, typename Graph>
+    bool consume_latest_into(Graph& graph) {
+        cached_head_ = header().head.load(std::memory_order_acquire);
+        if (cached_head_ == tail_) {
+            return false;
+        }
+        graph.template get_cell<I>().set_value(slots()[(cached_head_ - 1) & mask]);
+        tail_ = cached_head_;
+        header().tail.store(tail_, std::memory_order_release);
+        return true;
+    }
+};
+
+} // namespace frp
+
+#endif // FRP_SHM_RING_HPP
@@ -0,0 +1,613 @@
+/**
+ * @file frp_trace.hpp
+ * @brief Binary input trace recording for FRP graphs (POSIX)
+ *
+ * This header provides a recorder that appends every input cell write and
+ * signal fire to a preallocated, memory-mapped binary log:
+ * - Records are copied straight into the mapping, no syscall on the hot path
+ * - Segment files are preallocated and prefaulted when they are mapped
+ * - A spare segment is kept mapped so rolling over is a pointer swap
+ * - Unmapping and mapping segments happens in prepare(), off the hot path
+ *
+ * A matching reader maps recorded segments read-only and walks their records
+ * in order, e.g. to replay a trace into a graph.
+ */
+
+#ifndef FRP_TRACE_HPP
+#define FRP_TRACE_HPP
+
+#include "frp.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace frp {
+
+/**
+ * @brief Kind of a record in a trace segment
+ */
+enum class TraceRecordKind : std::uint8_t {
+    end = 0,         ///< No record; the zero-filled tail of a segment
+    cell_write = 1,  ///< An input cell was written
+    signal_fire = 2, ///< An input signal fired
+    output = 3       ///< An output value (used for recorded output traces)
+};
+
+/**
+ * @brief Header at the start of every trace segment file
+ */
+struct TraceSegmentHeader {
+    std::array<char, 8> magic;
+    std::uint32_t version;
+    std::uint32_t header_size;
+    std::uint64_t segment_index;
+    std::uint64_t capacity;  ///< Size of the record area in bytes
+    std::uint64_t used;      ///< Bytes of the record area holding complete records
+    std::uint64_t records;   ///< Number of complete records in the segment
+    std::array<std::uint64_t, 2> reserved;
+
+    static constexpr std::array<char, 8> expected_magic{'F', 'R', 'P', 'T', 'R', 'A', 'C', 'E'};
+    static constexpr std::uint32_t current_version = 1;
+};
+
+static_assert(sizeof(TraceSegmentHeader) == 64, "Trace segment header must stay 64 bytes");
+
+/**
+ * @brief Header preceding the payload of every trace record
+ *
+ * The payload follows the header and is padded to a multiple of 8 bytes.
+ */
+struct TraceRecordHeader {
+    std::uint64_t timestamp_ns;
+    std::uint32_t node_id;
+    std::uint16_t size;
+    TraceRecordKind kind;
+    std::uint8_t reserved;
+};
+
+static_assert(sizeof(TraceRecordHeader) == 16, "Trace record header must stay 16 bytes");
+
+/**
+ * @brief Concept for values that can be stored in a trace as raw bytes
+ */
+template<typename T>
+concept TraceValue = std::is_trivially_copyable_v<T> && (sizeof(T) <= 0xFFFF);
+
+namespace detail {
+    /**
+     * @brief Round a record payload size up to the record alignment
+     */
+    constexpr std::size_t trace_padded(std::size_t size) noexcept {
+        return (size + 7u) & ~std::size_t{7u};
+    }
+
+    /**
+     * @brief Build the file name of a trace segment into a fixed buffer
+     */
+    inline bool trace_segment_path(std::array<char, 256>& out, const char* prefix, std::uint64_t index) {
+        int n = std::snprintf(out.data(), out.size(), "%s.%06llu.frpt",
+                              prefix, static_cast<unsigned long long>(index));
+        return n > 0 && static_cast<std::size_t>(n) < out.size();
+    }
+
+    /**
+     * @brief A single memory-mapped trace segment
+     */
+    struct trace_segment {
+        int fd = -1;
+        std::byte* base = nullptr;
+        std::size_t mapped_bytes = 0;
+
+        constexpr bool is_mapped() const noexcept {
+            return base != nullptr;
+        }
+
+        TraceSegmentHeader& header() const noexcept {
+            return *reinterpret_cast<TraceSegmentHeader*>(base);
+        }
+
+        std::byte* records() const noexcept {
+            return base + sizeof(TraceSegmentHeader);
+        }
+
+        /**
+         * @brief Create, preallocate and map a segment file
+         */
+        bool map(const char* prefix, std::uint64_t index, std::size_t capacity) {
+            std::array<char, 256> path{};
+            if (!trace_segment_path(path, prefix, index)) {
+                return false;
+            }
+
+            fd = ::open(path.data(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+            if (fd < 0) {
+                return false;
+            }
+
+            mapped_bytes = sizeof(TraceSegmentHeader) + capacity;
+            // Reserve the blocks up front; filesystems without fallocate still
+            // get a sparse file from ftruncate.
+            if (::posix_fallocate(fd, 0, static_cast<off_t>(mapped_bytes)) != 0 &&
+                ::ftruncate(fd, static_cast<off_t>(mapped_bytes)) != 0) {
+                unmap_and_close(false);
+                return false;
+            }
+
+            void* addr = ::mmap(nullptr, mapped_bytes, PROT_READ | PROT_WRITE,
+                                MAP_SHARED | MAP_POPULATE, fd, 0);
+            if (addr == MAP_FAILED) {
+                unmap_and_close(false);
+                return false;
+            }
+            base = static_cast<std::byte*>(addr);
+
+            TraceSegmentHeader& h = header();
+            h.magic = TraceSegmentHeader::expected_magic;
+            h.version = TraceSegmentHeader::current_version;
+            h.header_size = sizeof(TraceSegmentHeader);
+            h.segment_index = index;
+            h.capacity = capacity;
+            h.used = 0;
+            h.records = 0;
+            return true;
+        }
+
+        /**
+         * @brief Unmap the segment, optionally trimming the file to its used size
+         */
+        void unmap_and_close(bool trim) {
+            std::size_t final_size = 0;
+            if (base) {
+                final_size = sizeof(TraceSegmentHeader) + static_cast<std::size_t>(header().used);
+                ::munmap(base, mapped_bytes);
+                base = nullptr;
+            }
+            if (fd >= 0) {
+                if (trim) {
+                    // Keep the zeroed end marker after the last record
+                    std::size_t marker = final_size + sizeof(TraceRecordHeader);
+                    if (marker < mapped_bytes) {
+                        [[maybe_unused]] int rc = ::ftruncate(fd, static_cast<off_t>(marker));
+                    }
+                }
+                ::close(fd);
+                fd = -1;
+            }
+            mapped_bytes = 0;
+        }
+    };
+} // namespace detail
+
+/**
+ * @brief Appends input events to a rolling set of memory-mapped segment files
+ *
+ * Segments are named `<prefix>.<index>.frpt`. Recording copies the record into
+ * the current mapping and bumps the segment's used counter; when a segment is
+ * full the recorder switches to the spare segment that was mapped in advance.
+ * Call prepare() outside the time-critical path (e.g. after each tick) to
+ * release full segments and map the next spare. If no spare is ready when a
+ * segment fills up, the recorder maps one inline and counts a stall.
+ *
+ * A recorder is meant to be used from a single thread.
+ */
+class TraceRecorder {
+private:
+    std::array<char, 256> prefix_{};
+    std::size_t capacity_ = 0;
+    std::uint64_t next_index_ = 0;
+
+    detail::trace_segment current_{};
+    detail::trace_segment spare_{};
+    detail::trace_segment retired_{};
+
+    std::uint64_t records_ = 0;
+    std::uint64_t dropped_ = 0;
+    std::uint64_t stalls_ = 0;
+
+    bool map_next(detail::trace_segment& seg) {
+        if (!seg.map(prefix_.data(), next_index_, capacity_)) {
+            return false;
+        }
+        ++next_index_;
+        return true;
+    }
+
+    bool roll_over() {
+        if (retired_.is_mapped()) {
+            retired_.unmap_and_close(true);
+            ++stalls_;
+        }
+        retired_ = current_;
+        current_ = {};
+
+        if (spare_.is_mapped()) {
+            current_ = spare_;
+            spare_ = {};
+            return true;
+        }
+
+        ++stalls_;
+        return map_next(current_);
+    }
+
+    static std::uint64_t now_ns() noexcept {
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+public:
+    /**
+     * @brief Default size of the record area of each segment (64 MiB)
+     */
+    static constexpr std::size_t default_segment_bytes = std::size_t{64} << 20;
+
+    TraceRecorder() = default;
+    TraceRecorder(const TraceRecorder&) = delete;
+    TraceRecorder& operator=(const TraceRecorder&) = delete;
+
+    ~TraceRecorder() {
+        close();
+    }
+
+    /**
+     * @brief Open a new trace, mapping the first segment and a spare
+     *
+     * @param prefix Path prefix of the segment files
+     * @param segment_bytes Size of the record area of each segment
+     * @return true if the first segment could be mapped
+     */
+    bool open(const char* prefix, std::size_t segment_bytes = default_segment_bytes) {
+        close();
+
+        std::size_t len = std::strlen(prefix);
+        if (len + 1 > prefix_.size() ||
+            segment_bytes < sizeof(TraceRecordHeader) + detail::trace_padded(0xFFFF)) {
+            return false;
+        }
+        std::memcpy(prefix_.data(), prefix, len + 1);
+        capacity_ = detail::trace_padded(segment_bytes);
+        next_index_ = 0;
+
+        if (!map_next(current_)) {
+            return false;
+        }
+        map_next(spare_);
+        return true;
+    }
+
+    /**
+     * @brief Flush and close all segments
+     *
+     * The final segment is trimmed to its used size; an unused spare is removed.
+     */
+    void close() {
+        retired_.unmap_and_close(true);
+        current_.unmap_and_close(true);
+        if (spare_.is_mapped()) {
+            spare_.unmap_and_close(false);
+            std::array<char, 256> path{};
+            if (detail::trace_segment_path(path, prefix_.data(), next_index_ - 1)) {
+                ::unlink(path.data());
+            }
+            --next_index_;
+        }
+    }
+
+    /**
+     * @brief Check whether the recorder has an open segment
+     */
+    bool is_open() const noexcept {
+        return current_.is_mapped();
+    }
+
+    /**
+     * @brief Release retired segments and map the next spare
+     *
+     * This performs the syscalls that recording avoids and should be called
+     * regularly from outside the time-critical path.
+     */
+    void prepare() {
+        if (retired_.is_mapped()) {
+            retired_.unmap_and_close(true);
+        }
+        if (current_.is_mapped() && !spare_.is_mapped()) {
+            map_next(spare_);
+        }
+    }
+
+    /**
+     * @brief Append a raw record
+     *
+     * @param kind Kind of the record
+     * @param node_id Identifier of the input node
+     * @param data Payload bytes
+     * @param size Payload size in bytes (at most 65535)
+     * @param timestamp_ns Timestamp of the event in nanoseconds
+     * @return true if the record was written
+     */
+    bool record_bytes(TraceRecordKind kind, std::uint32_t node_id,
+                      const void* data, std::size_t size, std::uint64_t timestamp_ns) {
+        if (!current_.is_mapped() || size > 0xFFFF) {
+            ++dropped_;
+            return false;
+        }
+
+        const std::size_t total = sizeof(TraceRecordHeader) + detail::trace_padded(size);
+        TraceSegmentHeader* h = &current_.header();
+        if (h->used + total > h->capacity) {
+            if (!roll_over()) {
+                ++dropped_;
+                return false;
+            }
+            h = &current_.header();
+        }
+
+        std::byte* dst = current_.records() + h->used;
+        TraceRecordHeader rec{timestamp_ns, node_id, static_cast<std::uint16_t>(size), kind, 0};
+        std::memcpy(dst, &rec, sizeof(rec));
+        std::memcpy(dst + sizeof(rec), data, size);
+
+        // Publish the record only after its bytes are in place, so a reader
+        // of a crashed process never sees a partial record as complete.
+        std::atomic_ref<std::uint64_t>(h->records).store(h->records + 1, std::memory_order_relaxed);
+        std::atomic_ref<std::uint64_t>(h->used).store(h->used + total, std::memory_order_release);
+        ++records_;
+        return true;
+    }
+
+    /**
+     * @brief Append a typed record with an explicit timestamp
+     */
+    template<TraceValue T>
+    bool record(TraceRecordKind kind, std::uint32_t node_id, const T& value, std::uint64_t timestamp_ns) {
+        return record_bytes(kind, node_id, &value, sizeof(T), timestamp_ns);
+    }
+
+    /**
+     * @brief Append a typed record stamped with the steady clock
+     */
+    template<TraceValue T>
+    bool record(TraceRecordKind kind, std::uint32_t node_id, const T& value) {
+        return record(kind, node_id, value, now_ns());
+    }
+
+    /**
+     * @brief Write an input cell of a graph and record the write
+     *
+     * The cell index is used as the node id of the record.
+     *
+     * @tparam I Index of the input cell
+     * @param graph Graph owning the cell
+     * @param value New value of the cell
+     */
+    template<std::size_t I, typename Graph, TraceValue T>
+    void write_cell(Graph& graph, const T& value) {
+        graph.template get_cell<I>().set_value(value);
+        record(TraceRecordKind::cell_write, static_cast<std::uint32_t>(I), value);
+    }
+
+    /**
+     * @brief Fire an input signal and record the occurrence
+     *
+     * @param signal Signal to fire
+     * @param node_id Identifier of the signal in the trace
+     * @param value Value carried by the signal
+     */
+    template<TraceValue T>
+    void fire(Signal<T>& signal, std::uint32_t node_id, const T& value) {
+        signal.fire(value);
+        record(TraceRecordKind::signal_fire, node_id, value);
+    }
+
+    /**
+     * @brief Number of records written since open()
+     */
+    std::uint64_t records() const noexcept {
+        return records_;
+    }
+
+    /**
+     * @brief Number of records that could not be written
+     */
+    std::uint64_t dropped() const noexcept {
+        return dropped_;
+    }
+
+    /**
+     * @brief Number of rollovers that had to map or unmap inline
+     */
+    std::uint64_t stalls() const noexcept {
+        return stalls_;
+    }
+
+    /**
+     * @brief Number of segment files created since open()
+     */
+    std::uint64_t segments() const noexcept {
+        return next_index_;
+    }
+};
+
+/**
+ * @brief Non-owning view of a record inside a mapped trace segment
+ */
+struct TraceRecordView {
+    TraceRecordKind kind = TraceRecordKind::end;
+    std::uint32_t node_id = 0;
+    std::uint64_t timestamp_ns = 0;
+    const std::byte* data = nullptr;
+    std::size_t size = 0;
+
+    /**
+     * @brief Copy the payload into a typed value
+     *
+     * @return false if the payload size does not match the type
+     */
+    template<TraceValue T>
+    bool get(T& out) const noexcept {
+        if (size != sizeof(T)) {
+            return false;
+        }
+        std::memcpy(&out, data, sizeof(T));
+        return true;
+    }
+
+    /**
+     * @brief Compare kind, node id and payload bytes of two records
+     */
+    bool same_event(const TraceRecordView& other) const noexcept {
+        return kind == other.kind && node_id == other.node_id && size == other.size &&
+               std::memcmp(data, other.data, size) == 0;
+    }
+};
+
+/**
+ * @brief Reads a recorded trace one segment mapping at a time
+ *
+ * Segments are mapped read-only in index order; only the current segment is
+ * mapped, so traces much larger than the address space budget can be read.
+ * Record views stay valid until the reader moves to the next segment.
+ */
+class TraceReader {
+private:
+    std::array<char, 256> prefix_{};
+    std::uint64_t index_ = 0;
+    const std::byte* base_ = nullptr;
+    std::size_t mapped_bytes_ = 0;
+    std::uint64_t used_ = 0;
+    std::uint64_t pos_ = 0;
+
+    void unmap() {
+        if (base_) {
+            ::munmap(const_cast<std::byte*>(base_), mapped_bytes_);
+            base_ = nullptr;
+        }
+        mapped_bytes_ = 0;
+        used_ = 0;
+        pos_ = 0;
+    }
+
+    bool map_segment(std::uint64_t index) {
+        unmap();
+
+        std::array<char, 256> path{};
+        if (!detail::trace_segment_path(path, prefix_.data(), index)) {
+            return false;
+        }
+        int fd = ::open(path.data(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            return false;
+        }
+
+        struct stat st{};
+        if (::fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < sizeof(TraceSegmentHeader)) {
+            ::close(fd);
+            return false;
+        }
+
+        void* addr = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (addr == MAP_FAILED) {
+            return false;
+        }
+        ::madvise(addr, static_cast<std::size_t>(st.st_size), MADV_SEQUENTIAL);
+
+        base_ = static_cast<const std::byte*>(addr);
+        mapped_bytes_ = static_cast<std::size_t>(st.st_size);
+        index_ = index;
+
+        TraceSegmentHeader h{};
+        std::memcpy(&h, base_, sizeof(h));
+        if (h.magic != TraceSegmentHeader::expected_magic ||
+            h.version != TraceSegmentHeader::current_version ||
+            h.header_size != sizeof(TraceSegmentHeader)) {
+            unmap();
+            return false;
+        }
+        // Never trust the header beyond what the file actually holds
+        used_ = std::min<std::uint64_t>(h.used, mapped_bytes_ - sizeof(TraceSegmentHeader));
+        return true;
+    }
+
+public:
+    TraceReader() = default;
+    TraceReader(const TraceReader&) = delete;
+    TraceReader& operator=(const TraceReader&) = delete;
+
+    ~TraceReader() {
+        unmap();
+    }
+
+    /**
+     * @brief Open a trace by its path prefix and map its first segment
+     */
+    bool open(const char* prefix) {
+        std::size_t len = std::strlen(prefix);
+        if (len + 1 > prefix_.size()) {
+            return false;
+        }
+        std::memcpy(prefix_.data(), prefix, len + 1);
+        return map_segment(0);
+    }
+
+    /**
+     * @brief Advance to the next record
+     *
+     * @param out Receives a view of the record
+     * @return false at the end of the trace
+     */
+    bool next(TraceRecordView& out) {
+        while (base_) {
+            if (pos_ + sizeof(TraceRecordHeader) <= used_) {
+                const std::byte* p = base_ + sizeof(TraceSegmentHeader) + pos_;
+                TraceRecordHeader rec{};
+                std::memcpy(&rec, p, sizeof(rec));
+                const std::size_t total = sizeof(rec) + detail::trace_padded(rec.size);
+                if (rec.kind != TraceRecordKind::end && pos_ + total <= used_) {
+                    out.kind = rec.kind;
+                    out.node_id = rec.node_id;
+                    out.timestamp_ns = rec.timestamp_ns;
+                    out.data = p + sizeof(rec);
+                    out.size = rec.size;
+                    pos_ += total;
+                    return true;
+                }
+            }
+            if (!map_segment(index_ + 1)) {
+                return false;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Visit every remaining record in order
+     *
+     * @return Number of records visited
+     */
+    template<typename F>
+    std::uint64_t for_each(F&& f) {
+        std::uint64_t count = 0;
+        TraceRecordView rec;
+        while (next(rec)) {
+            f(static_cast<const TraceRecordView&>(rec));
+            ++count;
+        }
+        return count;
+    }
+};
+
+} // namespace frp
+
+#endif // FRP_TRACE_HPP
@@ -0,0 +1,352 @@
+/**
+ * @file frp_uds.hpp
+ * @brief Unix-domain datagram socket input adapter for FRP graphs (Linux)
+ *
+ * This header feeds input cells from local producers that have to use sockets:
+ * - Datagrams are received in batches with one recvmmsg() call per batch
+ * - Receive buffers and message headers are preallocated in the source
+ * - Messages are decoded into typed input writes without allocation
+ * - A whole batch is applied to the graph as one transaction
+ *
+ * Every datagram carries one input write: a 32-bit node id (the index of the
+ * input cell, native byte order) followed by the raw bytes of the value.
+ * Input cells hold booleans (any nonzero byte is true) or values of which
+ * every bit pattern is valid (integers, floating point, arrays of those), so
+ * no datagram can produce an invalid object.
+ */
+
+#ifndef FRP_UDS_HPP
+#define FRP_UDS_HPP
+
+#include "frp.hpp"
+
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace frp {
+
+namespace detail {
+    /**
+     * @brief Fill a Unix-domain socket address
+     */
+    inline bool uds_address(sockaddr_un& addr, const char* path) {
+        std::size_t len = std::strlen(path);
+        if (len + 1 > sizeof(addr.sun_path)) {
+            return false;
+        }
+        std::memset(&addr, 0, sizeof(addr));
+        addr.sun_family = AF_UNIX;
+        std::memcpy(addr.sun_path, path, len + 1);
+        return true;
+    }
+
+    /**
+     * @brief Whether every bit pattern of T is a valid value, so untrusted bytes may be copied into it
+     */
+    template<typename T>
+    struct any_bit_pattern : std::bool_constant<std::is_arithmetic_v<T> && !std::is_same_v<T, bool>> {};
+
+    template<typename T, std::size_t N>
+    struct any_bit_pattern<std::array<T, N>> : any_bit_pattern<T> {};
+
+    /**
+     * @brief Write one decoded input into cell I if the node id and size match
+     */
+    template<std::size_t I, typename Graph>
+    bool uds_write_cell(Graph& graph, std::uint32_t node_id, std::span<const std::byte> payload) {
+        using T = std::remove_cvref_t<decltype(graph.template get_cell<I>().value())>;
+        static_assert(std::is_same_v<T, bool> || any_bit_pattern<T>::value,
+                      "Socket inputs must be bool or types whose every bit pattern is valid");
+        if (node_id != I || payload.size() != sizeof(T)) {
+            return false;
+        }
+        if constexpr (std::is_same_v<T, bool>) {
+            graph.template get_cell<I>().set_value(payload[0] != std::byte{0});
+        } else {
+            T value;
+            std::memcpy(&value, payload.data(), sizeof(T));
+            graph.template get_cell<I>().set_value(value);
+        }
+        return true;
+    }
+} // namespace detail
+
+/**
+ * @brief Receives input writes from a Unix-domain datagram socket in batches
+ *
+ * @tparam BatchSize Maximum number of datagrams received per call
+ * @tparam MaxDatagram Maximum size of a datagram in bytes; larger ones are dropped
+ */
+template<std::size_t BatchSize = 64, std::size_t MaxDatagram = 256>
+class UdsInputSource {
+private:
+    static_assert(MaxDatagram > sizeof(std::uint32_t), "Datagrams must be able to hold a node id");
+
+    int fd_ = -1;
+    std::array<char, sizeof(sockaddr_un::sun_path)> path_{};
+
+    alignas(8) std::array<std::array<std::byte, MaxDatagram>, BatchSize> buffers_{};
+    std::array<iovec, BatchSize> iovecs_{};
+    std::array<mmsghdr, BatchSize> messages_{};
+
+    std::uint64_t received_ = 0;
+    std::uint64_t malformed_ = 0;
+    std::uint64_t batches_ = 0;
+    std::uint64_t errors_ = 0;
+    int last_error_ = 0;
+
+public:
+    UdsInputSource() = default;
+    UdsInputSource(const UdsInputSource&) = delete;
+    UdsInputSource& operator=(const UdsInputSource&) = delete;
+
+    ~UdsInputSource() {
+        close();
+    }
+
+    /**
+     * @brief Bind a non-blocking datagram socket at a filesystem path
+     *
+     * A stale socket file at the path is removed first; if the path names
+     * anything other than a socket, it is left alone and open() fails.
+     */
+    bool open(const char* path) {
+        close();
+
+        sockaddr_un addr{};
+        if (!detail::uds_address(addr, path)) {
+            return false;
+        }
+        struct stat existing {};
+        if (::lstat(path, &existing) == 0) {
+            if (!S_ISSOCK(existing.st_mode) || ::unlink(path) != 0) {
+                return false;
+            }
+        } else if (errno != ENOENT) {
+            return false;
+        }
+        fd_ = ::socket(AF_UNIX, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (fd_ < 0) {
+            return false;
+        }
+        if (::bind(fd_, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) != 0) {
+            close();
+            return false;
+        }
+        std::memcpy(path_.data(), addr.sun_path, path_.size());
+
+        for (std::size_t i = 0; i < BatchSize; ++i) {
+            iovecs_[i].iov_base = buffers_[i].data();
+            iovecs_[i].iov_len = MaxDatagram;
+            messages_[i] = mmsghdr{};
+            messages_[i].msg_hdr.msg_iov = &iovecs_[i];
+            messages_[i].msg_hdr.msg_iovlen = 1;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Close the socket and remove its path
+     */
+    void close() {
+        if (fd_ >= 0) {
+            ::close(fd_);
+            fd_ = -1;
+        }
+        if (path_[0] != '\0') {
+            ::unlink(path_.data());
+            path_[0] = '\0';
+        }
+    }
+
+    /**
+     * @brief Socket descriptor, e.g. for registering with poll or epoll
+     */
+    int fd() const noexcept {
+        return fd_;
+    }
+
+    /**
+     * @brief Receive one batch and visit every well-formed message
+     *
+     * Never blocks; returns 0 when no datagram is pending. Receive errors
+     * also return 0; they are counted by errors() and the last one is kept
+     * in last_error().
+     *
+     * @param on_message Called with (node id, payload bytes) for each message
+     * @return Number of datagrams received, including malformed ones
+     */
+    template<typename F>
+    std::size_t receive(F&& on_message) {
+        if (fd_ < 0) {
+            return 0;
+        }
+        int n;
+        do {
+            n = ::recvmmsg(fd_, messages_.data(), static_cast<unsigned int>(BatchSize), MSG_DONTWAIT, nullptr);
+        } while (n < 0 && errno == EINTR);
+        if (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK) {
+            ++errors_;
+            last_error_ = errno;
+        }
+        if (n <= 0) {
+            return 0;
+        }
+
+        for (int i = 0; i < n; ++i) {
+            const mmsghdr& msg = messages_[static_cast<std::size_t>(i)];
+            const std::size_t len = msg.msg_len;
+            if ((msg.msg_hdr.msg_flags & MSG_TRUNC) || len < sizeof(std::uint32_t)) {
+                ++malformed_;
+                continue;
+            }
+            const std::byte* data = buffers_[static_cast<std::size_t>(i)].data();
+            std::uint32_t node_id;
+            std::memcpy(&node_id, data, sizeof(node_id));
+            on_message(node_id, std::span<const std::byte>(data + sizeof(node_id), len - sizeof(node_id)));
+        }
+
+        received_ += static_cast<std::uint64_t>(n);
+        ++batches_;
+        return static_cast<std::size_t>(n);
+    }
+
+    /**
+     * @brief Receive one batch into input cells and commit it as one transaction
+     *
+     * Every message is written into the input cell whose index equals its node
+     * id, provided that cell is listed in Is and the payload size matches the
+     * cell's value type. After the batch, commit() is called once if any cell
+     * was written, e.g. to propagate the changes through the graph.
+     *
+     * @tparam Is Indices of the input cells that may be written
+     * @param graph Graph owning the input cells
+     * @param commit Called once per batch after all writes are applied
+     * @return Number of input writes applied
+     */
+    template<std::size_t... Is, typename Graph, typename Commit>
+    std::size_t receive_into(Graph& graph, Commit&& commit) {
+        std::size_t applied = 0;
+        receive([&](std::uint32_t node_id, std::span<const std::byte> payload) {
+            if ((detail::uds_write_cell<Is>(graph, node_id, payload) || ...)) {
+                ++applied;
+            } else {
+                ++malformed_;
+            }
+        });
+        if (applied > 0) {
+            commit();
+        }
+        return applied;
+    }
+
+    /**
+     * @brief Number of datagrams received since open()
+     */
+    std::uint64_t received() const noexcept {
+        return received_;
+    }
+
+    /**
+     * @brief Number of datagrams that were truncated, too short or not decodable
+     */
+    std::uint64_t malformed() const noexcept {
+        return malformed_;
+    }
+
+    /**
+     * @brief Number of non-empty batches received
+     */
+    std::uint64_t batches() const noexcept {
+        return batches_;
+    }
+
+    /**
+     * @brief Number of failed receive calls (not counting "nothing pending")
+     */
+    std::uint64_t errors() const noexcept {
+        return errors_;
+    }
+
+    /**
+     * @brief errno of the last failed receive call, 0 if none failed
+     */
+    int last_error() const noexcept {
+        return last_error_;
+    }
+};
+
+/**
+ * @brief Sends input writes to a UdsInputSource
+ *
+ * Intended for local producers; each send() is one datagram.
+ */
+class UdsInputSender {
+private:
+    int fd_ = -1;
+    sockaddr_un addr_{};
+
+public:
+    UdsInputSender() = default;
+    UdsInputSender(const UdsInputSender&) = delete;
+    UdsInputSender& operator=(const UdsInputSender&) = delete;
+
+    ~UdsInputSender() {
+        close();
+    }
+
+    /**
+     * @brief Create an unbound datagram socket targeting a source path
+     */
+    bool open(const char* path) {
+        close();
+        if (!detail::uds_address(addr_, path)) {
+            return false;
+        }
+        fd_ = ::socket(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+        return fd_ >= 0;
+    }
+
+    /**
+     * @brief Close the socket
+     */
+    void close() {
+        if (fd_ >= 0) {
+            ::close(fd_);
+            fd_ = -1;
+        }
+    }
+
+    /**
+     * @brief Send one input write
+     *
+     * @param node_id Index of the input cell
+     * @param value Value to write
+     * @return true if the datagram was sent
+     */
+    template<typename T>
+        requires std::is_trivially_copyable_v<T>
+    bool send(std::uint32_t node_id, const T& value) {
+        std::array<std::byte, sizeof(std::uint32_t) + sizeof(T)> buffer;
+        std::memcpy(buffer.data(), &node_id, sizeof(node_id));
+        std::memcpy(buffer.data() + sizeof(node_id), &value, sizeof(T));
+        return ::sendto(fd_, buffer.data(), buffer.size(), 0,
+                        reinterpret_cast<const sockaddr*>(&addr_), sizeof(addr_)) ==
+               static_cast<ssize_t>(buffer.size());
+    }
+};
+
+} // namespace frp
+
+#endif // FRP_UDS_HPP
@@ -0,0 +1,490 @@
+/**
+ * @file frp_uring.hpp
+ * @brief Asynchronous file sink backed by io_uring (Linux)
+ *
+ * This header provides a sink that logs signal payloads to a file without
+ * ever blocking the control thread on disk I/O:
+ * - Payloads are appended into a fixed set of registered buffers
+ * - Full buffers are written with IORING_OP_WRITE_FIXED at explicit offsets
+ * - All writes queued during a tick are submitted with one io_uring_enter()
+ * - The number of buffers in flight is bounded; a drop policy decides what
+ *   happens when every buffer is busy
+ *
+ * The rings are set up with raw syscalls, so liburing is not required.
+ */
+
+#ifndef FRP_URING_HPP
+#define FRP_URING_HPP
+
+#include "frp.hpp"
+
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace frp {
+
+/**
+ * @brief What a sink does with a payload when no buffer is free
+ */
+enum class DropPolicy {
+    drop_newest,  ///< Discard the payload and count it as dropped
+    block         ///< Wait for an in-flight write to complete
+};
+
+namespace detail {
+    /**
+     * @brief Minimal io_uring instance driven through raw syscalls
+     */
+    class uring {
+    private:
+        int fd_ = -1;
+        void* sq_ptr_ = nullptr;
+        std::size_t sq_bytes_ = 0;
+        void* cq_ptr_ = nullptr;
+        std::size_t cq_bytes_ = 0;
+        io_uring_sqe* sqes_ = nullptr;
+        std::size_t sqes_bytes_ = 0;
+
+        unsigned* sq_tail_ = nullptr;
+        unsigned sq_mask_ = 0;
+        unsigned* sq_array_ = nullptr;
+        unsigned* cq_head_ = nullptr;
+        unsigned* cq_tail_ = nullptr;
+        unsigned cq_mask_ = 0;
+        io_uring_cqe* cqes_ = nullptr;
+
+        unsigned local_tail_ = 0;
+        unsigned to_submit_ = 0;
+
+        template<typename P>
+        static P* at(void* base, unsigned offset) noexcept {
+            return reinterpret_cast<P*>(static_cast<std::byte*>(base) + offset);
+        }
+
+    public:
+        uring() = default;
+        uring(const uring&) = delete;
+        uring& operator=(const uring&) = delete;
+
+        ~uring() {
+            close();
+        }
+
+        bool open(unsigned entries) {
+            io_uring_params params{};
+            fd_ = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+            if (fd_ < 0) {
+                return false;
+            }
+
+            sq_bytes_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+            cq_bytes_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+            const bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+            if (single_mmap && cq_bytes_ > sq_bytes_) {
+                sq_bytes_ = cq_bytes_;
+            }
+
+            sq_ptr_ = ::mmap(nullptr, sq_bytes_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                             fd_, IORING_OFF_SQ_RING);
+            if (sq_ptr_ == MAP_FAILED) {
+                sq_ptr_ = nullptr;
+                close();
+                return false;
+            }
+            if (single_mmap) {
+                cq_ptr_ = sq_ptr_;
+            } else {
+                cq_ptr_ = ::mmap(nullptr, cq_bytes_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                                 fd_, IORING_OFF_CQ_RING);
+                if (cq_ptr_ == MAP_FAILED) {
+                    cq_ptr_ = nullptr;
+                    close();
+                    return false;
+                }
+            }
+
+            sqes_bytes_ = params.sq_entries * sizeof(io_uring_sqe);
+            void* sqes = ::mmap(nullptr, sqes_bytes_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                                fd_, IORING_OFF_SQES);
+            if (sqes == MAP_FAILED) {
+                close();
+                return false;
+            }
+            sqes_ = static_cast<io_uring_sqe*>(sqes);
+
+            sq_tail_ = at<unsigned>(sq_ptr_, params.sq_off.tail);
+            sq_mask_ = *at<unsigned>(sq_ptr_, params.sq_off.ring_mask);
+            sq_array_ = at<unsigned>(sq_ptr_, params.sq_off.array);
+            cq_head_ = at<unsigned>(cq_ptr_, params.cq_off.head);
+            cq_tail_ = at<unsigned>(cq_ptr_, params.cq_off.tail);
+            cq_mask_ = *at<unsigned>(cq_ptr_, params.cq_off.ring_mask);
+            cqes_ = at<io_uring_cqe>(cq_ptr_, params.cq_off.cqes);
+
+            local_tail_ = *sq_tail_;
+            to_submit_ = 0;
+            return true;
+        }
+
+        void close() {
+            if (sqes_) {
+                ::munmap(sqes_, sqes_bytes_);
+                sqes_ = nullptr;
+            }
+            if (cq_ptr_ && cq_ptr_ != sq_ptr_) {
+                ::munmap(cq_ptr_, cq_bytes_);
+            }
+            cq_ptr_ = nullptr;
+            if (sq_ptr_) {
+                ::munmap(sq_ptr_, sq_bytes_);
+                sq_ptr_ = nullptr;
+            }
+            if (fd_ >= 0) {
+                ::close(fd_);
+                fd_ = -1;
+            }
+        }
+
+        bool register_buffers(const iovec* iovecs, unsigned count) {
+            return ::syscall(__NR_io_uring_register, fd_, IORING_REGISTER_BUFFERS, iovecs, count) == 0;
+        }
+
+        /**
+         * @brief Queue a fixed-buffer write; it is sent to the kernel by submit()
+         */
+        void queue_write_fixed(int file_fd, const void* data, unsigned len, std::uint64_t offset,
+                               std::uint16_t buf_index, std::uint64_t user_data) noexcept {
+            const unsigned index = local_tail_ & sq_mask_;
+            io_uring_sqe& sqe = sqes_[index];
+            std::memset(&sqe, 0, sizeof(sqe));
+            sqe.opcode = IORING_OP_WRITE_FIXED;
+            sqe.fd = file_fd;
+            sqe.addr = reinterpret_cast<std::uint64_t>(data);
+            sqe.len = len;
+            sqe.off = offset;
+            sqe.buf_index = buf_index;
+            sqe.user_data = user_data;
+            sq_array_[index] = index;
+            ++local_tail_;
+            ++to_submit_;
+        }
+
+        /**
+         * @brief Publish queued writes and optionally wait for completions
+         *
+         * @return false if the kernel rejected the call
+         */
+        bool submit(unsigned wait_for = 0) noexcept {
+            std::atomic_ref<unsigned>(*sq_tail_).store(local_tail_, std::memory_order_release);
+            if (to_submit_ == 0 && wait_for == 0) {
+                return true;
+            }
+            long rc;
+            do {
+                rc = ::syscall(__NR_io_uring_enter, fd_, to_submit_, wait_for,
+                               wait_for ? IORING_ENTER_GETEVENTS : 0u, nullptr, 0);
+            } while (rc < 0 && errno == EINTR);
+            if (rc < 0) {
+                return false;
+            }
+            to_submit_ -= static_cast<unsigned>(rc) < to_submit_ ? static_cast<unsigned>(rc) : to_submit_;
+            return true;
+        }
+
+        /**
+         * @brief Visit and retire every available completion
+         */
+        template<typename F>
+        unsigned reap(F&& f) noexcept {
+            unsigned head = *cq_head_;
+            const unsigned tail = std::atomic_ref<unsigned>(*cq_tail_).load(std::memory_order_acquire);
+            unsigned count = 0;
+            while (head != tail) {
+                const io_uring_cqe& cqe = cqes_[head & cq_mask_];
+                f(cqe.user_data, cqe.res);
+                ++head;
+                ++count;
+            }
+            std::atomic_ref<unsigned>(*cq_head_).store(head, std::memory_order_release);
+            return count;
+        }
+    };
+} // namespace detail
+
+/**
+ * @brief Sink that appends signal payloads to a file through io_uring
+ *
+ * Payloads are copied into the current fill buffer. When it cannot take the
+ * next payload, or at flush(), the buffer is queued for writing. flush() is
+ * meant to be called once per tick: it submits every queued write with a
+ * single syscall and retires completed writes without waiting.
+ *
+ * The sink owns Buffers * BufferBytes bytes of buffer storage, so it is best
+ * placed in static storage.
+ *
+ * @tparam T Payload type (trivially copyable)
+ * @tparam Buffers Number of registered buffers, i.e. the in-flight bound
+ * @tparam BufferBytes Size of each buffer
+ */
+template<CellValue T, std::size_t Buffers = 8, std::size_t BufferBytes = 16384>
+class UringFileSink {
+private:
+    static_assert(std::is_trivially_copyable_v<T>, "File sink payloads must be trivially copyable");
+    static_assert(sizeof(T) <= BufferBytes, "Payload does not fit into a buffer");
+    static_assert(Buffers > 0 && Buffers <= 0xFFFF, "Invalid number of buffers");
+
+    static constexpr std::size_t no_buffer = Buffers;
+
+    alignas(4096) std::array<std::array<std::byte, BufferBytes>, Buffers> buffers_{};
+    std::array<std::size_t, Buffers> free_list_{};
+    std::size_t free_count_ = 0;
+    std::array<std::size_t, Buffers> fill_{};
+    std::array<std::size_t, Buffers> done_{};        // Bytes of a queued buffer already written
+    std::array<std::uint64_t, Buffers> offsets_{};   // File offset of a queued buffer
+
+    detail::uring ring_;
+    int file_fd_ = -1;
+    DropPolicy policy_ = DropPolicy::drop_newest;
+    std::size_t current_ = no_buffer;
+    std::size_t in_flight_ = 0;
+    std::uint64_t file_offset_ = 0;
+
+    std::uint64_t written_ = 0;
+    std::uint64_t dropped_ = 0;
+    std::uint64_t errors_ = 0;
+
+    void queue_slot(std::size_t slot) noexcept {
+        ring_.queue_write_fixed(file_fd_, buffers_[slot].data() + done_[slot],
+                                static_cast<unsigned>(fill_[slot] - done_[slot]), offsets_[slot] + done_[slot],
+                                static_cast<std::uint16_t>(slot), slot);
+    }
+
+    void retire_completions() noexcept {
+        ring_.reap([this](std::uint64_t slot, int res) {
+            if (res > 0) {
+                written_ += static_cast<std::uint64_t>(res);
+                done_[slot] += static_cast<std::size_t>(res);
+                if (done_[slot] < fill_[slot]) {
+                    // Short write: queue the rest, or the file would have a hole
+                    queue_slot(static_cast<std::size_t>(slot));
+                    return;
+                }
+            } else {
+                ++errors_;
+            }
+            fill_[slot] = 0;
+            free_list_[free_count_++] = static_cast<std::size_t>(slot);
+            --in_flight_;
+        });
+    }
+
+    void queue_current() noexcept {
+        if (current_ == no_buffer) {
+            return;
+        }
+        const std::size_t len = fill_[current_];
+        if (len == 0) {
+            free_list_[free_count_++] = current_;
+            current_ = no_buffer;
+            return;
+        }
+        done_[current_] = 0;
+        offsets_[current_] = file_offset_;
+        queue_slot(current_);
+        file_offset_ += len;
+        ++in_flight_;
+        current_ = no_buffer;
+    }
+
+    bool acquire_buffer() noexcept {
+        if (free_count_ == 0) {
+            retire_completions();
+        }
+        if (free_count_ == 0 && policy_ == DropPolicy::block) {
+            while (free_count_ == 0 && ring_.submit(1)) {
+                retire_completions();
+            }
+        }
+        if (free_count_ == 0) {
+            return false;
+        }
+        current_ = free_list_[--free_count_];
+        fill_[current_] = 0;
+        return true;
+    }
+
+public:
+    UringFileSink() = default;
+    UringFileSink(const UringFileSink&) = delete;
+    UringFileSink& operator=(const UringFileSink&) = delete;
+
+    ~UringFileSink() {
+        close();
+    }
+
+    /**
+     * @brief Create (truncate) the output file and set up the ring
+     *
+     * @param path Path of the output file
+     * @param policy What to do with payloads when all buffers are in flight
+     * @return true if the file is open and the buffers are registered
+     */
+    bool open(const char* path, DropPolicy policy = DropPolicy::drop_newest) {
+        close();
+
+        file_fd_ = ::open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (file_fd_ < 0) {
+            return false;
+        }
+        // Twice as many entries as buffers, so queuing never has to wait for room
+        if (!ring_.open(static_cast<unsigned>(Buffers * 2))) {
+            close();
+            return false;
+        }
+
+        std::array<iovec, Buffers> iovecs{};
+        for (std::size_t i = 0; i < Buffers; ++i) {
+            iovecs[i].iov_base = buffers_[i].data();
+            iovecs[i].iov_len = BufferBytes;
+            free_list_[i] = Buffers - 1 - i;
+            fill_[i] = 0;
+        }
+        if (!ring_.register_buffers(iovecs.data(), static_cast<unsigned>(Buffers))) {
+            close();
+            return false;
+        }
+
+        free_count_ = Buffers;
+        policy_ = policy;
+        current_ = no_buffer;
+        in_flight_ = 0;
+        file_offset_ = 0;
+        written_ = dropped_ = errors_ = 0;
+        return true;
+    }
+
+    /**
+     * @brief Write all pending payloads, wait for them and close the file
+     */
+    void close() {
+        if (file_fd_ >= 0) {
+            flush();
+            while (in_flight_ > 0 && ring_.submit(1)) {
+                retire_completions();
+            }
+            ::close(file_fd_);
+            file_fd_ = -1;
+        }
+        ring_.close();
+    }
+
+    /**
+     * @brief Check whether the sink is open
+     */
+    bool is_open() const noexcept {
+        return file_fd_ >= 0;
+    }
+
+    /**
+     * @brief Append one payload
+     *
+     * @return false if the payload was dropped
+     */
+    bool write(const T& value) noexcept {
+        if (file_fd_ < 0) {
+            ++dropped_;
+            return false;
+        }
+        if (current_ != no_buffer && fill_[current_] + sizeof(T) > BufferBytes) {
+            queue_current();
+        }
+        if (current_ == no_buffer && !acquire_buffer()) {
+            ++dropped_;
+            return false;
+        }
+        std::memcpy(buffers_[current_].data() + fill_[current_], &value, sizeof(T));
+        fill_[current_] += sizeof(T);
+        return true;
+    }
+
+    /**
+     * @brief Append the payload of a signal if it occurred
+     */
+    void process(const Signal<T>& signal) noexcept {
+        if (signal.occurred()) {
+            write(signal.value());
+        }
+    }
+
+    /**
+     * @brief Submit everything written so far and retire completed writes
+     *
+     * Call once per tick. Never waits for the disk.
+     */
+    void flush() noexcept {
+        if (file_fd_ < 0) {
+            return;
+        }
+        queue_current();
+        if (!ring_.submit(0)) {
+            ++errors_;
+        }
+        retire_completions();
+        // Submit the rest of short writes retired just now
+        if (!ring_.submit(0)) {
+            ++errors_;
+        }
+    }
+
+    /**
+     * @brief Create an frp::Sink that forwards to this file sink
+     */
+    Sink<T> sink() {
+        return Sink<T>([this](const T& value) { write(value); });
+    }
+
+    /**
+     * @brief Number of bytes confirmed written to the file
+     */
+    std::uint64_t written_bytes() const noexcept {
+        return written_;
+    }
+
+    /**
+     * @brief Number of payloads dropped because no buffer was free
+     */
+    std::uint64_t dropped() const noexcept {
+        return dropped_;
+    }
+
+    /**
+     * @brief Number of failed writes
+     *
+     * Short writes are not errors: the rest is written by another request.
+     */
+    std::uint64_t errors() const noexcept {
+        return errors_;
+    }
+
+    /**
+     * @brief Number of buffers currently queued or being written
+     */
+    std::size_t in_flight() const noexcept {
+        return in_flight_;
+    }
+};
+
+} // namespace frp
+
+#endif // FRP_URING_HPP
@@ -6,7 +6,12 @@
  * classes defined in example.hpp.
  */
 
+#ifndef NDEBUG
+#define FRP_HEAP_GUARD_IMPLEMENTATION
+#endif
+
 #include "frp.hpp"
+#include "frp_heap_guard.hpp"
 #include "example.hpp"
 #include <iostream>
 #include <iomanip>
@@ -31,7 +36,8 @@ int main() {
     // Demonstrate the temperature sensor system
     print_section("Temperature Sensor System");
     {
-        example::TemperatureSensorSystem temp_system;
+        // Initial state propagated at compile time; no constructor runs here
+        static constinit example::TemperatureSensorSystem temp_system;
         
         // Initial state
         print_subsection("Initial State");
@@ -73,6 +79,9 @@ int main() {
         
         print_subsection("Processing Various Signals");
         
+        // Debug builds abort if signal processing touches the heap
+        frp::heap_guard no_heap;
+        
         // Process a value below threshold (should not be processed)
         std::cout << "Processing value 5 (below threshold):\n";
         signal_system.process_input(5);
@@ -92,7 +101,7 @@ int main() {
     // Demonstrate the motor control system
     print_section("Motor Control System");
     {
-        example::MotorControlSystem motor_system;
+        static constinit example::MotorControlSystem motor_system;
         
         // Initial state
         print_subsection("Initial State");
@@ -126,7 +135,7 @@ int main() {
         
         // Create cells
         frp::Cell<int> counter(0);
-        frp::Cell<std::string> message("Hello, FRP!");
+        frp::Cell<frp::fixed_string<32>> message("Hello, FRP!");
         
         // Create behaviors from cells
         auto counter_behavior = frp::behavior_from_cell(counter);
@@ -134,8 +143,11 @@ int main() {
         
         // Create a derived behavior using lift
         auto combined_behavior = frp::lift(
-            [](int count, const std::string& msg) {
-                return msg + " Count: " + std::to_string(count);
+            [](int count, const frp::fixed_string<32>& msg) {
+                frp::fixed_string<48> text(msg);
+                text += " Count: ";
+                text.append(count);
+                return text;
             },
             counter_behavior,
             message_behavior
@@ -143,14 +155,14 @@ int main() {
         
         // Sample the behaviors
         std::cout << "Counter: " << counter_behavior.sample() << "\n";
-        std::cout << "Message: " << message_behavior.sample() << "\n";
-        std::cout << "Combined: " << combined_behavior.sample() << "\n\n";
+        std::cout << "Message: " << message_behavior.sample().view() << "\n";
+        std::cout << "Combined: " << combined_behavior.sample().view() << "\n\n";
         
         // Update a cell and sample again
         counter.set_value(42);
         std::cout << "After updating counter to 42:\n";
         std::cout << "Counter: " << counter_behavior.sample() << "\n";
-        std::cout << "Combined: " << combined_behavior.sample() << "\n";
+        std::cout << "Combined: " << combined_behavior.sample().view() << "\n";
     }
     
     {
@@ -0,0 +1,368 @@
+/**
+ * @file replay.cpp
+ * @brief Deterministic high-speed replay of recorded input traces
+ *
+ * This tool memory-maps an input trace recorded with frp::TraceRecorder and
+ * drives one of the example systems with it as fast as possible. Time is
+ * simulated: every event is stamped with its recorded timestamp, so replaying
+ * the same trace always produces the same output trace. The tool reports
+ * throughput and can compare the outputs against a recorded output trace.
+ * Heap allocations made while replaying are counted and reported.
+ *
+ * Usage:
+ *   frp_replay <temperature|motor> <input-prefix> [options]
+ *
+ * Options:
+ *   --expect <prefix>       Compare outputs against a recorded output trace
+ *   --record <prefix>       Record the outputs as a new trace
+ *   --synthesize <count>    Generate a synthetic input trace first
+ *   --profile-layout <file> Record cell co-access and write a layout header
+ *   --forbid-alloc          Fail (exit code 3) if replaying allocated
+ */
+
+#define FRP_HEAP_GUARD_IMPLEMENTATION
+#define FRP_HEAP_AUDIT_MALLOC
+
+
+#include "frp.hpp"
+#include "frp_trace.hpp"
+#include "frp_heap_guard.hpp"
+#include "frp_layout_profile.hpp"
+#include "example.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <type_traits>
+
+namespace {
+
+/**
+ * @brief Replay adapter for the temperature sensor system
+ *
+ * Inputs: node 0 = sensor 1 raw (float), node 1 = sensor 2 raw (float)
+ * Outputs: node 4 = average temperature (float), node 5 = alert (bool)
+ */
+template<typename Layout = frp::by_alignment>
+struct TemperatureReplay {
+    static constexpr const char* layout_name = "temperature_layout";
+
+    example::BasicTemperatureSensorSystem<Layout> system;
+
+    bool apply(const frp::TraceRecordView& rec) {
+        float raw = 0.0f;
+        if (!rec.get(raw)) {
+            return false;
+        }
+        switch (rec.node_id) {
+            case 0: system.update_sensor1(raw); return true;
+            case 1: system.update_sensor2(raw); return true;
+            default: return false;
+        }
+    }
+
+    template<typename Out>
+    void emit(Out&& out) const {
+        out(4u, system.get_average_temperature());
+        out(5u, system.is_alert_active());
+    }
+
+    static void synthesize(frp::TraceRecorder& recorder, std::uint64_t count, std::uint64_t& rng) {
+        for (std::uint64_t i = 0; i < count; ++i) {
+            rng = rng * 6364136223846793005ull + 1442695040888963407ull;
+            float raw = static_cast<float>((rng >> 33) % 1000u);
+            recorder.record(frp::TraceRecordKind::cell_write, static_cast<std::uint32_t>(i & 1u), raw, i * 1000u);
+            if ((i & 1023u) == 0) {
+                recorder.prepare();
+            }
+        }
+    }
+};
+
+/**
+ * @brief Replay adapter for the motor control system
+ *
+ * Inputs: node 0 = throttle (float), node 1 = temperature (float),
+ *         node 2 = emergency stop (bool)
+ * Outputs: node 3 = motor power (float)
+ */
+template<typename Layout = frp::by_alignment>
+struct MotorReplay {
+    static constexpr const char* layout_name = "motor_layout";
+
+    example::BasicMotorControlSystem<Layout> system;
+
+    bool apply(const frp::TraceRecordView& rec) {
+        switch (rec.node_id) {
+            case 0: {
+                float v = 0.0f;
+                return rec.get(v) && (system.set_throttle(v), true);
+            }
+            case 1: {
+                float v = 0.0f;
+                return rec.get(v) && (system.update_temperature(v), true);
+            }
+            case 2: {
+                bool v = false;
+                return rec.get(v) && (system.set_emergency_stop(v), true);
+            }
+            default:
+                return false;
+        }
+    }
+
+    template<typename Out>
+    void emit(Out&& out) const {
+        out(3u, system.get_motor_power());
+    }
+
+    static void synthesize(frp::TraceRecorder& recorder, std::uint64_t count, std::uint64_t& rng) {
+        for (std::uint64_t i = 0; i < count; ++i) {
+            rng = rng * 6364136223846793005ull + 1442695040888963407ull;
+            std::uint32_t r = static_cast<std::uint32_t>(rng >> 33);
+            std::uint64_t ts = i * 1000u;
+            switch (r % 16u) {
+                case 0:
+                    recorder.record(frp::TraceRecordKind::cell_write, 2u, (r & 0x100u) != 0, ts);
+                    break;
+                case 1: case 2: case 3:
+                    recorder.record(frp::TraceRecordKind::cell_write, 1u,
+                                    60.0f + static_cast<float>(r % 4000u) / 100.0f, ts);
+                    break;
+                default:
+                    recorder.record(frp::TraceRecordKind::cell_write, 0u,
+                                    static_cast<float>(r % 1001u) / 1000.0f, ts);
+                    break;
+            }
+            if ((i & 1023u) == 0) {
+                recorder.prepare();
+            }
+        }
+    }
+};
+
+struct Options {
+    const char* system = nullptr;
+    const char* input = nullptr;
+    const char* expect = nullptr;
+    const char* record = nullptr;
+    const char* profile_layout = nullptr;
+    std::uint64_t synthesize = 0;
+    bool forbid_alloc = false;
+};
+
+/**
+ * @brief Compares produced outputs against an expected output trace
+ */
+struct OutputChecker {
+    frp::TraceReader reader;
+    bool enabled = false;
+    std::uint64_t compared = 0;
+    std::uint64_t mismatches = 0;
+    std::uint64_t first_mismatch_ns = 0;
+
+    void check(const frp::TraceRecordView& produced) {
+        frp::TraceRecordView expected;
+        if (!reader.next(expected)) {
+            ++mismatches;
+        } else if (!produced.same_event(expected) || produced.timestamp_ns != expected.timestamp_ns) {
+            ++mismatches;
+        } else {
+            ++compared;
+            return;
+        }
+        if (mismatches == 1) {
+            first_mismatch_ns = produced.timestamp_ns;
+        }
+    }
+
+    bool has_trailing_records() {
+        frp::TraceRecordView rec;
+        return reader.next(rec);
+    }
+};
+
+/**
+ * @brief Access profile filled by --profile-layout runs (one system per run)
+ */
+using ReplayProfile = frp::AccessProfile<64>;
+
+template<typename Replay, typename Profile = void>
+int run(const Options& opts) {
+    if (opts.synthesize > 0) {
+        frp::TraceRecorder recorder;
+        if (!recorder.open(opts.input)) {
+            std::cerr << "Cannot create input trace " << opts.input << "\n";
+            return 1;
+        }
+        std::uint64_t rng = 0x2545F4914F6CDD1Dull;
+        Replay::synthesize(recorder, opts.synthesize, rng);
+        recorder.close();
+        std::cout << "Synthesized " << opts.synthesize << " input records\n";
+    }
+
+    frp::TraceReader input;
+    if (!input.open(opts.input)) {
+        std::cerr << "Cannot open input trace " << opts.input << "\n";
+        return 1;
+    }
+
+    OutputChecker checker;
+    if (opts.expect) {
+        if (!checker.reader.open(opts.expect)) {
+            std::cerr << "Cannot open expected output trace " << opts.expect << "\n";
+            return 1;
+        }
+        checker.enabled = true;
+    }
+
+    frp::TraceRecorder output;
+    if (opts.record && !output.open(opts.record)) {
+        std::cerr << "Cannot create output trace " << opts.record << "\n";
+        return 1;
+    }
+
+    Replay replay;
+    std::uint64_t events = 0;
+    std::uint64_t rejected = 0;
+    std::uint64_t first_ns = 0;
+    std::uint64_t last_ns = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    frp::allocation_audit audit;
+
+    frp::TraceRecordView rec;
+    while (input.next(rec)) {
+        if (events == 0) {
+            first_ns = rec.timestamp_ns;
+        }
+        last_ns = rec.timestamp_ns;
+        ++events;
+
+        if (rec.kind != frp::TraceRecordKind::cell_write || !replay.apply(rec)) {
+            ++rejected;
+            continue;
+        }
+
+        if constexpr (!std::is_void_v<Profile>) {
+            // Read the outputs as a consumer would, so they count as accessed
+            replay.emit([](std::uint32_t, const auto&) {});
+            Profile::end_tick();
+        }
+
+        if (!checker.enabled && !opts.record) {
+            continue;
+        }
+        replay.emit([&](std::uint32_t node_id, const auto& value) {
+            frp::TraceRecordView produced;
+            produced.kind = frp::TraceRecordKind::output;
+            produced.node_id = node_id;
+            produced.timestamp_ns = rec.timestamp_ns;
+            produced.data = reinterpret_cast<const std::byte*>(&value);
+            produced.size = sizeof(value);
+            if (checker.enabled) {
+                checker.check(produced);
+            }
+            if (opts.record) {
+                output.record(frp::TraceRecordKind::output, node_id, value, rec.timestamp_ns);
+            }
+        });
+        if (opts.record && (events & 1023u) == 0) {
+            output.prepare();
+        }
+    }
+
+    const std::uint64_t allocations = audit.allocations();
+    const std::uint64_t allocated_bytes = audit.bytes();
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    double simulated = static_cast<double>(last_ns - first_ns) * 1e-9;
+
+    std::cout << "Replayed " << events << " events (" << rejected << " rejected) in "
+              << elapsed << " s\n";
+    if (elapsed > 0.0) {
+        std::cout << "Throughput: " << static_cast<double>(events) / elapsed << " events/s\n";
+        std::cout << "Simulated time: " << simulated << " s (" << simulated / elapsed
+                  << "x real time)\n";
+    }
+
+    std::cout << "Heap allocations: " << allocations << " (" << allocated_bytes << " bytes)\n";
+
+    int status = 0;
+    if (checker.enabled) {
+        if (checker.has_trailing_records()) {
+            ++checker.mismatches;
+        }
+        std::cout << "Outputs compared: " << checker.compared << ", mismatches: "
+                  << checker.mismatches << "\n";
+        if (checker.mismatches > 0) {
+            std::cout << "First mismatch at t=" << checker.first_mismatch_ns << " ns\n";
+            status = 2;
+        }
+    }
+    if (opts.record) {
+        std::cout << "Recorded " << output.records() << " output records\n";
+    }
+    if (opts.forbid_alloc && allocations > 0 && status == 0) {
+        status = 3;
+    }
+    if constexpr (!std::is_void_v<Profile>) {
+        if (!Profile::write_header(opts.profile_layout, Replay::layout_name)) {
+            std::cerr << "Cannot write layout header " << opts.profile_layout << "\n";
+            return 1;
+        }
+        std::cout << "Profiled " << Profile::ticks() << " ticks over " << Profile::elements()
+                  << " cells, layout written to " << opts.profile_layout << "\n";
+    }
+    return status;
+}
+
+void print_usage() {
+    std::cerr << "Usage: frp_replay <temperature|motor> <input-prefix> "
+                 "[--expect <prefix>] [--record <prefix>] [--synthesize <count>] "
+                 "[--profile-layout <file>] [--forbid-alloc]\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        print_usage();
+        return 1;
+    }
+
+    Options opts;
+    opts.system = argv[1];
+    opts.input = argv[2];
+    for (int i = 3; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--expect") == 0 && i + 1 < argc) {
+            opts.expect = argv[++i];
+        } else if (std::strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            opts.record = argv[++i];
+        } else if (std::strcmp(argv[i], "--synthesize") == 0 && i + 1 < argc) {
+            opts.synthesize = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--profile-layout") == 0 && i + 1 < argc) {
+            opts.profile_layout = argv[++i];
+        } else if (std::strcmp(argv[i], "--forbid-alloc") == 0) {
+            opts.forbid_alloc = true;
+        } else {
+            print_usage();
+            return 1;
+        }
+    }
+
+    using ProfiledLayout = frp::profiled_layout<ReplayProfile>;
+    if (std::strcmp(opts.system, "temperature") == 0) {
+        return opts.profile_layout
+            ? run<TemperatureReplay<ProfiledLayout>, ReplayProfile>(opts)
+            : run<TemperatureReplay<>>(opts);
+    }
+    if (std::strcmp(opts.system, "motor") == 0) {
+        return opts.profile_layout
+            ? run<MotorReplay<ProfiledLayout>, ReplayProfile>(opts)
+            : run<MotorReplay<>>(opts);
+    }
+    print_usage();
+    return 1;
+}